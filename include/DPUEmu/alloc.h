@@ -0,0 +1,10 @@
+#ifndef DPU_EMU_ALLOC_H
+#define DPU_EMU_ALLOC_H
+
+#include "dpu_emu_runtime.h"
+
+// WRAM heap, shared by the tasklets of a DPU and reset on every launch.
+static inline void *mem_alloc(size_t size) { return dpu_emu_mem_alloc(size); }
+static inline void mem_reset(void) { dpu_emu_mem_reset(); }
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef DPU_EMU_BARRIER_H
+#define DPU_EMU_BARRIER_H
+
+#include "dpu_emu_runtime.h"
+
+typedef struct barrier_t {
+  unsigned int count;
+} barrier_t;
+
+// Every tasklet of the launch takes part, as on the DPU.
+#define BARRIER_INIT(name, counter) barrier_t name = {(counter)}
+
+static inline void barrier_wait(barrier_t *barrier) {
+  (void)barrier;
+  dpu_emu_barrier_wait();
+}
+
+#endif
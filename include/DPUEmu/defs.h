@@ -0,0 +1,15 @@
+#ifndef DPU_EMU_DEFS_H
+#define DPU_EMU_DEFS_H
+
+#include "dpu_emu_runtime.h"
+
+#ifndef NR_TASKLETS
+#define NR_TASKLETS 12
+#endif
+
+// Read by the emulator to size the tasklet pool of this program.
+__attribute__((weak)) const unsigned int dpu_emu_nr_tasklets = NR_TASKLETS;
+
+static inline unsigned int me(void) { return dpu_emu_tasklet_id; }
+
+#endif
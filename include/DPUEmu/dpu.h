@@ -0,0 +1,125 @@
+#ifndef DPU_EMU_DPU_H
+#define DPU_EMU_DPU_H
+
+// Host-emulated subset of the UPMEM host API used by MetaPB. Built when
+// METAPB_DPU_EMULATION is on, this header then shadows the SDK <dpu.h>.
+//
+// A DPU is a sparse 64MiB host mapping standing in for its MRAM, a program is
+// a kernel from src/Operator/dpu compiled as a host shared object, and a
+// launch runs NR_TASKLETS host threads per DPU, one DPU after another.
+// Launches and transfers are then dilated to the wall-clock time given by a
+// calibration, see src/DPUEmu/DPUEmu.cpp.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Set only by this header, so host code can tell timings taken on the
+// emulator from ones measured on DPUs.
+#define METAPB_DPU_EMULATED 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t dpu_error_t;
+#define DPU_OK 0
+#define DPU_ERR_INTERNAL 1
+#define DPU_ERR_SYSTEM 2
+#define DPU_ERR_ALLOCATION 3
+#define DPU_ERR_INVALID_SYMBOL_ACCESS 4
+#define DPU_ERR_INVALID_MEMORY_TRANSFER 5
+#define DPU_ERR_ELF_INVALID_FILE 6
+
+#define DPU_ALLOCATE_ALL ((uint32_t)-1)
+
+struct dpu_rank_t;
+struct dpu_t;
+struct dpu_program_t;
+
+enum dpu_set_kind_t { DPU_SET_RANKS, DPU_SET_DPU };
+
+struct dpu_set_t {
+  enum dpu_set_kind_t kind;
+  union {
+    struct {
+      uint32_t nr_ranks;
+      struct dpu_rank_t **ranks;
+    } list;
+    struct dpu_t *dpu;
+  };
+};
+
+typedef enum dpu_launch_policy_t {
+  DPU_ASYNCHRONOUS,
+  DPU_SYNCHRONOUS,
+} dpu_launch_policy_t;
+
+typedef enum dpu_xfer_t {
+  DPU_XFER_TO_DPU,
+  DPU_XFER_FROM_DPU,
+} dpu_xfer_t;
+
+typedef enum dpu_xfer_flags_t {
+  DPU_XFER_DEFAULT = 0,
+  DPU_XFER_NO_RESET = 1 << 0,
+  DPU_XFER_ASYNC = 1 << 1,
+} dpu_xfer_flags_t;
+
+typedef enum dpu_sg_xfer_flags_t {
+  DPU_SG_XFER_DEFAULT = 0,
+  DPU_SG_XFER_ASYNC = 1 << 0,
+  DPU_SG_XFER_DISABLE_LENGTH_CHECK = 1 << 1,
+} dpu_sg_xfer_flags_t;
+
+struct sg_block_info {
+  uint8_t *addr;
+  uint32_t length;
+};
+
+typedef bool (*get_block_func_t)(struct sg_block_info *out, uint32_t dpu_index,
+                                 uint32_t block_index, void *args);
+
+typedef struct get_block_t {
+  get_block_func_t f;
+  void *args;
+  size_t args_size;
+} get_block_t;
+
+dpu_error_t dpu_alloc(uint32_t nr_dpus, const char *profile,
+                      struct dpu_set_t *dpu_set);
+dpu_error_t dpu_alloc_ranks(uint32_t nr_ranks, const char *profile,
+                            struct dpu_set_t *dpu_set);
+dpu_error_t dpu_free(struct dpu_set_t dpu_set);
+dpu_error_t dpu_get_nr_dpus(struct dpu_set_t dpu_set, uint32_t *nr_dpus);
+dpu_error_t dpu_get_nr_ranks(struct dpu_set_t dpu_set, uint32_t *nr_ranks);
+dpu_error_t dpu_load(struct dpu_set_t dpu_set, const char *binary_path,
+                     struct dpu_program_t **program);
+dpu_error_t dpu_broadcast_to(struct dpu_set_t dpu_set, const char *symbol_name,
+                             uint32_t symbol_offset, const void *src,
+                             size_t length, dpu_xfer_flags_t flags);
+dpu_error_t dpu_launch(struct dpu_set_t dpu_set, dpu_launch_policy_t policy);
+dpu_error_t dpu_sync(struct dpu_set_t dpu_set);
+dpu_error_t dpu_push_sg_xfer(struct dpu_set_t dpu_set, dpu_xfer_t xfer,
+                             const char *symbol_name, uint32_t symbol_offset,
+                             size_t length, get_block_t *get_block_info,
+                             dpu_sg_xfer_flags_t flags);
+const char *dpu_error_to_string(dpu_error_t status);
+
+#define DPU_ASSERT(statement)                                                  \
+  do {                                                                         \
+    dpu_error_t __error = (statement);                                         \
+    if (__error != DPU_OK) {                                                   \
+      fprintf(stderr, "%s:%d(%s): DPU Error (%s)\n", __FILE__, __LINE__,       \
+              __func__, dpu_error_to_string(__error));                         \
+      exit(EXIT_FAILURE);                                                      \
+    }                                                                          \
+  } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
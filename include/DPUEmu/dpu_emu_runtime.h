@@ -0,0 +1,29 @@
+#ifndef DPU_EMU_RUNTIME_H
+#define DPU_EMU_RUNTIME_H
+
+// Hooks between kernels compiled for the host and the DPU emulator
+// (src/DPUEmu). Every tasklet is a host thread, these thread-locals tell it
+// which emulated DPU it runs on.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern __thread char *dpu_emu_mram;             // MRAM of the running DPU
+extern __thread unsigned int dpu_emu_tasklet_id;
+extern __thread size_t dpu_emu_mram_bytes;      // MRAM traffic of the tasklet
+
+void *dpu_emu_mem_alloc(size_t size);
+void dpu_emu_mem_reset(void);
+void dpu_emu_barrier_wait(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define DPU_EMU_PAGE_BYTE 4096
+
+#endif
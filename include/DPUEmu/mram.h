@@ -0,0 +1,33 @@
+#ifndef DPU_EMU_MRAM_H
+#define DPU_EMU_MRAM_H
+
+#include "alloc.h"
+#include "defs.h"
+#include "dpu_emu_runtime.h"
+#include <string.h>
+
+#define __mram_ptr
+#define __mram_noinit
+#define __host
+#define __dma_aligned __attribute__((aligned(8)))
+
+// Kernels declare their MRAM as `__mram_noinit page_t buffer[N]`. Here the
+// declaration turns into one of a function returning the MRAM of the DPU
+// the calling tasklet runs on, so one kernel image serves every DPU.
+static inline char (*dpu_emu_mram_buffer(void))[][DPU_EMU_PAGE_BYTE] {
+  return (char (*)[][DPU_EMU_PAGE_BYTE])dpu_emu_mram;
+}
+#define buffer (*dpu_emu_mram_buffer())
+
+static inline void mram_read(const void *from, void *to, unsigned int nb) {
+  memcpy(to, from, nb);
+  dpu_emu_mram_bytes += nb;
+}
+
+static inline void mram_write(const void *from, const void *to,
+                              unsigned int nb) {
+  memcpy((void *)to, from, nb);
+  dpu_emu_mram_bytes += nb;
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef DPU_EMU_PERFCOUNTER_H
+#define DPU_EMU_PERFCOUNTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint64_t perfcounter_t;
+typedef enum { COUNT_SAME, COUNT_CYCLES, COUNT_INSTRUCTIONS } perfcounter_config_t;
+
+// No cycle-accurate model, kernel time comes from the emulator calibration.
+static inline perfcounter_t perfcounter_config(perfcounter_config_t config,
+                                               bool reset_value) {
+  (void)config;
+  (void)reset_value;
+  return 0;
+}
+static inline perfcounter_t perfcounter_get(void) { return 0; }
+
+#endif
@@ -5,13 +5,18 @@ extern "C" {
 #include <dpu.h>
 }
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <memory>
 
 struct GLOBAL_DPU_MGR {
-  dpu_set_t dpu_set;
-  std::uint32_t dpuNum;
+  dpu_set_t dpu_set;       // active view, every launch goes here
+  dpu_set_t allocated_set; // what dpu_alloc returned, freed on exit
+  std::uint32_t dpuNum = 0;
+  std::uint32_t allocatedDPUNum = 0;
+  std::uint32_t rankNum = 0;
+  std::uint32_t activeRankNum = 0;
   inline static bool isAllocated = false;
   inline static bool isFreed = false;
   GLOBAL_DPU_MGR(const GLOBAL_DPU_MGR &) = delete;
@@ -26,17 +31,38 @@ struct GLOBAL_DPU_MGR {
       DPU_ASSERT(dpu_get_nr_dpus(dpu_set, &result));
       std::cout << "Allocated " << result << " DPU(s)\n";
       this->dpuNum = result;
+      this->allocatedDPUNum = result;
+      allocated_set = dpu_set;
+      DPU_ASSERT(dpu_get_nr_ranks(dpu_set, &rankNum));
+      activeRankNum = rankNum;
       isAllocated = true;
       isFreed = false;
     }
   }
-  const std::uint32_t getDPUNum() const noexcept {
-    std::cout << "returned from MGR dpuNum: "<< dpuNum <<std::endl;
-    return dpuNum;
+  /// @brief DPUs of the active view, masked-out DPUs excluded.
+  const std::uint32_t getDPUNum() const noexcept { return dpuNum; }
+  const std::uint32_t getAllocatedDPUNum() const noexcept {
+    return allocatedDPUNum;
+  }
+  const std::uint32_t getRankNum() const noexcept { return rankNum; }
+  const std::uint32_t getActiveRankNum() const noexcept {
+    return activeRankNum;
+  }
+
+  /// @brief Narrow the active view to the first rankNum ranks, the others
+  /// stay allocated but idle. The view shares the allocated rank list.
+  void useRanks(std::uint32_t rankNum) noexcept {
+    if (allocated_set.kind != DPU_SET_RANKS)
+      return;
+    rankNum = std::clamp<std::uint32_t>(rankNum, 1, this->rankNum);
+    dpu_set = allocated_set;
+    dpu_set.list.nr_ranks = rankNum;
+    DPU_ASSERT(dpu_get_nr_dpus(dpu_set, &dpuNum));
+    activeRankNum = rankNum;
   }
   ~GLOBAL_DPU_MGR() noexcept {
     if (!isFreed) {
-      DPU_ASSERT(dpu_free(dpu_set));
+      DPU_ASSERT(dpu_free(allocated_set));
       std::cout << "All UPMEM-PIM DPU are safely deallocated." << std::endl;
       std::cout << "###########################################" << std::endl;
       isFreed = true;
@@ -0,0 +1,95 @@
+#ifndef CLUSTER_MODEL_HPP
+#define CLUSTER_MODEL_HPP
+
+#include "Executor/TaskGraph.hpp"
+#include "utils/Stats.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace MetaPB {
+namespace Distributed {
+
+using Executor::Graph;
+using Executor::TaskGraph;
+using Executor::TaskNode;
+using utils::perfStats;
+
+/// @brief Linear cost of the coordinator <-> worker link.
+typedef struct NetworkModel {
+  double latency_Second = 50e-6;
+  double bandwidth_MiBps = 1100.0; // ~10GbE payload rate
+  double energyPerMiB_Joule = 0.0; // NIC energy is not metered yet
+
+  inline perfStats deduceXfer(const double size_MiB,
+                              const uint32_t msgNum) const noexcept {
+    perfStats perf;
+    perf.timeCost_Second =
+        msgNum * latency_Second + size_MiB / bandwidth_MiBps;
+    perf.energyCost_Joule = size_MiB * energyPerMiB_Joule;
+    perf.dataMovement_MiB = size_MiB;
+    return perf;
+  }
+} NetworkModel;
+
+/// @brief Data-parallel partition: every node runs the whole graph over its
+/// contiguous share of each node's data.
+inline TaskGraph partitionGraph(const TaskGraph &tg, const uint32_t nodeIdx,
+                                const uint32_t nodeNum) noexcept {
+  Graph g = tg.g;
+  auto vertices = boost::vertices(g);
+  for (auto vi = vertices.first; vi != vertices.second; ++vi) {
+    const size_t size_MiB = g[*vi].inputSize_MiB;
+    g[*vi].inputSize_MiB =
+        size_MiB * (nodeIdx + 1) / nodeNum - size_MiB * nodeIdx / nodeNum;
+  }
+  return TaskGraph(g, tg.getName());
+}
+
+/// @brief Bytes crossing the network per batch: scattering the inputs of
+/// LOGIC_START successors and gathering the outputs of LOGIC_END
+/// predecessors. Everything in between stays node-local. Only the cost is
+/// modeled, the transport carries graphs, schedules and stats while workers
+/// read their share from their own pool. A reduction gathers one partial per
+/// DPU, dpuNum per node.
+inline double boundaryXfer_MiB(const TaskGraph &tg,
+                               const uint32_t dpuNum) noexcept {
+  const Graph &g = tg.g;
+  double size_MiB = 0.0f;
+  auto edges = boost::edges(g);
+  for (auto ei = edges.first; ei != edges.second; ++ei) {
+    const auto &src = g[boost::source(*ei, g)];
+    const auto &dst = g[boost::target(*ei, g)];
+    if (src.op == OperatorTag::LOGIC_START) {
+      size_MiB += g[*ei].dataSize_Ratio * dst.inputSize_MiB;
+    } else if (dst.op == OperatorTag::LOGIC_END) {
+      size_MiB += g[*ei].dataSize_Ratio *
+                  Operator::outputSize_MiB(src.op, src.inputSize_MiB, dpuNum);
+    }
+  }
+  return size_MiB;
+}
+
+/// @brief Cluster-wide cost: nodes run concurrently, the coordinator link
+/// is shared so boundary traffic is serialised on it.
+inline perfStats deduceCluster(const std::vector<perfStats> &nodeStats,
+                               const NetworkModel &net,
+                               const double boundary_MiB) noexcept {
+  perfStats result;
+  for (const auto &perf : nodeStats) {
+    result.timeCost_Second =
+        std::max(result.timeCost_Second, perf.timeCost_Second);
+    result.energyCost_Joule += perf.energyCost_Joule;
+    result.dataMovement_MiB += perf.dataMovement_MiB;
+  }
+  const perfStats netPerf =
+      net.deduceXfer(boundary_MiB, 2 * (uint32_t)nodeStats.size());
+  result.timeCost_Second += netPerf.timeCost_Second;
+  result.energyCost_Joule += netPerf.energyCost_Joule;
+  result.dataMovement_MiB += netPerf.dataMovement_MiB;
+  return result;
+}
+
+} // namespace Distributed
+} // namespace MetaPB
+#endif
@@ -0,0 +1,49 @@
+#ifndef COORDINATOR_HPP
+#define COORDINATOR_HPP
+
+#include "Distributed/ClusterModel.hpp"
+#include "Distributed/Transport.hpp"
+#include "Distributed/Wire.hpp"
+#include "Executor/HeteroComputePool.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MetaPB {
+namespace Distributed {
+
+using Executor::execType;
+
+/// @brief Splits every batch across worker processes and merges their
+/// reports. Workers are contacted through any Transport, so a single box can
+/// host the whole cluster over Unix sockets. Cross-node data transfer is
+/// model-only: boundary bytes are charged through NetworkModel, never sent.
+class Coordinator {
+public:
+  /// @brief dpuNum is the DPUs of every worker, it sizes the reduction
+  /// outputs gathered over the network.
+  Coordinator(const std::vector<std::string> &workerEndpoints,
+              const NetworkModel &net, const uint32_t dpuNum) noexcept;
+
+  inline uint32_t getNodeNum() const noexcept { return workers.size(); }
+  inline bool isValid() const noexcept {
+    return !workers.empty() && validWorkerNum == workers.size();
+  }
+
+  /// @brief Run each node's share on its worker, concurrently.
+  perfStats execWorkload(const TaskGraph &tg, const Schedule &sched,
+                         execType eT) noexcept;
+
+  /// @brief Ask every worker to leave its serving loop.
+  void shutdownWorkers() noexcept;
+
+private:
+  std::vector<std::unique_ptr<Transport>> workers;
+  size_t validWorkerNum = 0;
+  NetworkModel net;
+  uint32_t dpuNum;
+};
+
+} // namespace Distributed
+} // namespace MetaPB
+#endif
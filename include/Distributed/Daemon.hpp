@@ -0,0 +1,99 @@
+#ifndef DAEMON_HPP
+#define DAEMON_HPP
+
+#include "Distributed/Transport.hpp"
+#include "Distributed/Wire.hpp"
+#include "Executor/HeteroComputePool.hpp"
+#include "Operator/OperatorManager.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace MetaPB {
+namespace Distributed {
+
+using Executor::execType;
+using Executor::HeteroComputePool;
+using Operator::OperatorManager;
+using utils::DatasetSource;
+using utils::ResultSink;
+
+/// @brief How the daemon obtains the schedule of a submitted graph.
+enum class SchedulerKind : uint8_t {
+  GIVEN, // schedule is shipped with the job
+  HEFT,
+  META,
+};
+
+/// @brief One graph-execution request to MetaPBd.
+typedef struct daemonJob {
+  TaskGraph tg;
+  execType eT = execType::MIMIC;
+  SchedulerKind schedKind = SchedulerKind::META;
+  Schedule sched; // GIVEN only
+  double alpha = 0.5f;
+  double beta = 0.5f;
+  uint32_t optIterMax = 200;
+  // Binary file on the daemon host that LOGIC_START feeds from in DO mode,
+  // empty for the memory pool.
+  std::string datasetPath;
+  // Directory on the daemon host the outputs of LOGIC_END predecessors are
+  // written to in DO mode, empty to keep them in the pool only.
+  std::string sinkDir;
+} daemonJob;
+
+typedef struct daemonReply {
+  perfStats perf;
+  Schedule sched;
+  bool isScheduleCached = false;
+} daemonReply;
+
+void encodeJob(WireWriter &w, const daemonJob &job) noexcept;
+bool decodeJob(WireReader &r, daemonJob &job) noexcept;
+void encodeReply(WireWriter &w, const daemonReply &reply) noexcept;
+bool decodeReply(WireReader &r, daemonReply &reply) noexcept;
+
+/// @brief Resident scheduler/executor. DPUs stay allocated, operators and
+/// their perf models stay loaded, and schedules are memoized per graph, so
+/// a job only pays for scheduling misses and execution.
+class Daemon {
+public:
+  Daemon(void **memPoolPtr) noexcept : memPoolPtr(memPoolPtr) {
+    om.instantiateAll();
+  }
+
+  /// @brief Serve clients one at a time until a SHUTDOWN arrives.
+  void serve(const std::string &endpoint) noexcept;
+
+private:
+  daemonReply handleJob(const daemonJob &job) noexcept;
+  // Only probe/load models that are missing or too small for this graph.
+  void warmModels(const TaskGraph &tg) noexcept;
+
+  OperatorManager om;
+  void **memPoolPtr;
+  std::map<OperatorTag, size_t> trainedUpperBound_MiB;
+  std::set<int> trainedElemTypes;
+  std::unordered_map<uint64_t, Schedule> scheduleCache;
+  bool isShuttingDown = false;
+};
+
+/// @brief Thin client of MetaPBd, holds one connection.
+class DaemonClient {
+public:
+  DaemonClient(const std::string &endpoint) noexcept
+      : peer(SocketTransport::connectTo(endpoint)) {}
+  inline bool isValid() const noexcept { return peer != nullptr; }
+  bool submit(const daemonJob &job, daemonReply &reply) noexcept;
+  void shutdownDaemon() noexcept;
+
+private:
+  std::unique_ptr<SocketTransport> peer;
+};
+
+} // namespace Distributed
+} // namespace MetaPB
+#endif
@@ -0,0 +1,81 @@
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Frames carry graphs, schedules and stats, a larger length is a corrupt
+// or hostile peer.
+#define TRANSPORT_MAX_FRAME_BYTE (64ull << 20)
+
+namespace MetaPB {
+namespace Distributed {
+
+/// @brief Message kinds exchanged between coordinator and workers.
+enum class MsgKind : uint32_t {
+  EXEC_MIMIC, // graph + schedule, deduce only
+  EXEC_DO,    // graph + schedule, execute for real
+  RESULT,     // perfStats of the last job
+  SHUTDOWN,   // worker leaves its serving loop
+  SUBMIT,     // daemon job: graph + how to schedule it
+  UNDEFINED
+};
+
+/// @brief Reliable, ordered byte stream between two MetaPB processes.
+class Transport {
+public:
+  virtual ~Transport() noexcept = default;
+  virtual bool sendAll(const void *buf, const size_t size_Byte) noexcept = 0;
+  virtual bool recvAll(void *buf, const size_t size_Byte) noexcept = 0;
+  virtual bool isValid() const noexcept = 0;
+
+  /// @brief Length-prefixed framing on top of the byte stream, frames over
+  /// TRANSPORT_MAX_FRAME_BYTE are refused on both ends.
+  bool sendFrame(const MsgKind kind, const std::vector<char> &payload) noexcept;
+  bool recvFrame(MsgKind &kind, std::vector<char> &payload) noexcept;
+};
+
+/// @brief Stream socket transport, endpoints are "unix:<path>" for local
+/// testing or "tcp:<host>:<port>" across servers.
+class SocketTransport : public Transport {
+public:
+  explicit SocketTransport(int fd) noexcept : fd(fd) {}
+  SocketTransport(const SocketTransport &) = delete;
+  SocketTransport &operator=(const SocketTransport &) = delete;
+  ~SocketTransport() noexcept override;
+
+  bool sendAll(const void *buf, const size_t size_Byte) noexcept override;
+  bool recvAll(void *buf, const size_t size_Byte) noexcept override;
+  inline bool isValid() const noexcept override { return fd >= 0; }
+
+  /// @brief Connect to a listening endpoint, nullptr on failure.
+  static std::unique_ptr<SocketTransport>
+  connectTo(const std::string &endpoint) noexcept;
+
+private:
+  int fd = -1;
+};
+
+/// @brief Passive side of SocketTransport.
+class SocketListener {
+public:
+  explicit SocketListener(const std::string &endpoint) noexcept;
+  SocketListener(const SocketListener &) = delete;
+  SocketListener &operator=(const SocketListener &) = delete;
+  ~SocketListener() noexcept;
+
+  inline bool isValid() const noexcept { return fd >= 0; }
+  /// @brief Block until a peer connects, nullptr on failure.
+  std::unique_ptr<SocketTransport> accept() noexcept;
+
+private:
+  std::string endpoint;
+  int fd = -1;
+};
+
+} // namespace Distributed
+} // namespace MetaPB
+#endif
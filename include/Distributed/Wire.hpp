@@ -0,0 +1,85 @@
+#ifndef WIRE_HPP
+#define WIRE_HPP
+
+#include "Executor/TaskGraph.hpp"
+#include "utils/Stats.hpp"
+#include "utils/typedef.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#define WIRE_MAGIC 0x4D504247 // "MPBG"
+#define WIRE_VERSION 6
+
+namespace MetaPB {
+namespace Distributed {
+
+using Executor::TaskGraph;
+using utils::perfStats;
+using utils::Schedule;
+
+/// @brief Append-only little-endian binary encoder, hosts on both ends are
+/// assumed to share endianness.
+class WireWriter {
+public:
+  WireWriter(std::vector<char> &buf) noexcept : buf(buf) {}
+  template <typename T> void put(const T &val) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const size_t pos = buf.size();
+    buf.resize(pos + sizeof(T));
+    memcpy(buf.data() + pos, &val, sizeof(T));
+  }
+  void putString(const std::string &str) noexcept {
+    put<uint32_t>(str.size());
+    buf.insert(buf.end(), str.begin(), str.end());
+  }
+
+private:
+  std::vector<char> &buf;
+};
+
+/// @brief Bounds-checked decoder, any overrun latches isValid() to false.
+class WireReader {
+public:
+  WireReader(const std::vector<char> &buf) noexcept : buf(buf) {}
+  template <typename T> T get() noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T val{};
+    if (!ok || pos + sizeof(T) > buf.size()) {
+      ok = false;
+      return val;
+    }
+    memcpy(&val, buf.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return val;
+  }
+  std::string getString() noexcept {
+    const uint32_t len = get<uint32_t>();
+    if (!ok || pos + len > buf.size()) {
+      ok = false;
+      return {};
+    }
+    std::string str(buf.data() + pos, len);
+    pos += len;
+    return str;
+  }
+  inline bool isValid() const noexcept { return ok; }
+
+private:
+  const std::vector<char> &buf;
+  size_t pos = 0;
+  bool ok = true;
+};
+
+void encodeGraph(WireWriter &w, const TaskGraph &tg) noexcept;
+bool decodeGraph(WireReader &r, TaskGraph &tg) noexcept;
+void encodeSchedule(WireWriter &w, const Schedule &sched) noexcept;
+bool decodeSchedule(WireReader &r, Schedule &sched) noexcept;
+void encodePerf(WireWriter &w, const perfStats &perf) noexcept;
+bool decodePerf(WireReader &r, perfStats &perf) noexcept;
+
+} // namespace Distributed
+} // namespace MetaPB
+#endif
@@ -0,0 +1,38 @@
+#ifndef WORKER_HPP
+#define WORKER_HPP
+
+#include "Distributed/Transport.hpp"
+#include "Distributed/Wire.hpp"
+#include "Executor/HeteroComputePool.hpp"
+#include "Operator/OperatorManager.hpp"
+#include <string>
+
+namespace MetaPB {
+namespace Distributed {
+
+using Executor::HeteroComputePool;
+using Operator::OperatorManager;
+
+/// @brief One PIM server of a cluster. Owns its OperatorManager and memory
+/// pool, executes whatever graph partition the coordinator ships.
+class Worker {
+public:
+  Worker(OperatorManager &om, void **memPoolPtr) noexcept
+      : om(om), memPoolPtr(memPoolPtr) {}
+
+  /// @brief Serve coordinators on endpoint until one sends SHUTDOWN.
+  void serve(const std::string &endpoint) noexcept;
+
+private:
+  // Returns false once the session should end.
+  bool handleFrame(Transport &peer, const MsgKind kind,
+                   const std::vector<char> &payload) noexcept;
+
+  OperatorManager &om;
+  void **memPoolPtr;
+  bool isShuttingDown = false;
+};
+
+} // namespace Distributed
+} // namespace MetaPB
+#endif
@@ -3,25 +3,36 @@
 #include "Executor/TaskGraph.hpp"
 #include "Operator/OperatorManager.hpp"
 #include "utils/ChronoTrigger.hpp"
+#include "utils/DatasetSource.hpp"
 #include "utils/MetricsGather.hpp"
+#include "utils/OutputCache.hpp"
+#include "utils/ResultSink.hpp"
 #include "utils/Stats.hpp"
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <cstdlib>
 #include <fstream>
 #include <functional>
 #include <iomanip>
+#include <numeric>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <random>
 #include <string>
 #include <thread>
 #include <tuple>
+#include <unistd.h>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+// Used when the L2 size cannot be queried.
+#define CPU_REGION_L2_FALLBACK_BYTE (1 << 20)
+
 namespace MetaPB {
 namespace Executor {
 using Operator::CPU_TCB;
@@ -31,8 +42,11 @@ using DPU_TCB = Operator::DPU_TCB;
 using Operator::opType2Name;
 using Operator::tag2Name;
 using utils::ChronoTrigger;
+using utils::DatasetSource;
 using utils::metricTag;
+using utils::OutputCache;
 using utils::perfStats;
+using utils::ResultSink;
 using utils::Stats;
 // TaskTiming struct to store start and end times for tasks
 typedef struct TaskTiming {
@@ -55,6 +69,23 @@ enum class EUType { CPU, DPU };
 
 typedef std::tuple<EUType, OperatorTag, size_t> perfTag;
 
+// One operator of a CPU region. A fused entry continues the element-wise
+// chain of the entry before it.
+typedef struct {
+  OperatorTag op;
+  CPU_TCB cpuTCB;
+  bool isFused = false;
+  int elemType = INT32_32ALN;
+} regionOp;
+
+// A DPU-resident chain launched once as the ELEW_FUSED program: src1 of its
+// head, dst of its tail and a stage per member in order.
+typedef struct {
+  DPU_TCB dpuTCB;
+  std::vector<chain_stage> stages;
+  int tailId = -1;
+} dpuChain;
+
 typedef struct {
   bool isCompleted = false;
   double completeTime_ms = 0.0f; // time elapsed from begin. maintained in MIMIC
@@ -68,8 +99,23 @@ public:
 
   HeteroComputePool(HeteroComputePool &&other) noexcept
       : memPoolPtr(std::exchange(other.memPoolPtr, nullptr)),
+        dataset(std::exchange(other.dataset, nullptr)),
+        sink(std::exchange(other.sink, nullptr)),
+        outputCache(std::exchange(other.outputCache, nullptr)),
         memPoolNum(std::exchange(other.memPoolNum, 0)), om(other.om), mutex_(),
         cv_(), dpuMutex_(), dependencies_(std::move(other.dependencies_)),
+        orderPos_(std::move(other.orderPos_)),
+        dpuDependencies_(std::move(other.dpuDependencies_)),
+        dpuLauncher_(std::move(other.dpuLauncher_)),
+        dpuPageBaseIdx_(std::move(other.dpuPageBaseIdx_)),
+        dpuBatchPageCnt_(std::move(other.dpuBatchPageCnt_)),
+        bcastPageIdx_(std::move(other.bcastPageIdx_)),
+        bcastPageCnt_(std::move(other.bcastPageCnt_)),
+        bcastPred_(std::move(other.bcastPred_)),
+        src2WrapPageCnt_(std::move(other.src2WrapPageCnt_)),
+        dpuSlot_(std::move(other.dpuSlot_)),
+        dpuFinishCycles_(std::move(other.dpuFinishCycles_)),
+        dpuReductions_(std::move(other.dpuReductions_)),
         cpuCompleted_(std::move(other.cpuCompleted_)),
         dpuCompleted_(std::move(other.dpuCompleted_)),
         mapCompleted_(std::move(other.mapCompleted_)),
@@ -91,6 +137,33 @@ public:
   perfStats execWorkload(const TaskGraph &g, const Schedule &sched,
                          execType) noexcept;
 
+  /// @brief Feed successors of LOGIC_START in g straight from a mapped file
+  /// instead of the memory pool, nullptr falls back to the pool. A file
+  /// smaller than what those nodes read is rejected, the pool stays bound.
+  bool bindDataset(const TaskGraph &g, const DatasetSource *ds) noexcept;
+
+  /// @brief Persist outputs of LOGIC_END predecessors as they complete in DO
+  /// mode, nullptr disables write-back.
+  inline void bindSink(ResultSink *rs) noexcept { sink = rs; }
+
+  /// @brief Skip nodes whose output is cached for the same inputs and keep
+  /// fully host-resident outputs of the rest in DO mode, nullptr disables
+  /// memoization.
+  inline void bindOutputCache(OutputCache *oc) noexcept { outputCache = oc; }
+
+  /// @brief Per-DPU cycles of the last DO run, for skew-aware operators.
+  inline const std::unordered_map<int, std::vector<uint64_t>> &
+  getDPUFinishCycles() const noexcept {
+    return dpuFinishCycles_;
+  }
+
+  /// @brief Combined DPU share of every reduction of the last DO run, the
+  /// CPU share stays in the pool.
+  inline const std::unordered_map<int, int64_t> &
+  getDPUReductions() const noexcept {
+    return dpuReductions_;
+  }
+
   // Print timings for each type of task
   void printTimings() const noexcept;
   void outputTimingsToCSV(const std::string &filename) const noexcept;
@@ -111,6 +184,12 @@ private:
 
   void cleanStatus(int taskNum) noexcept;
 
+  // Chain sink submissions after the CPU and REDUCE tasks of a sink node.
+  void attachSink(const TaskGraph &g, int taskId, const CPU_TCB &cpuTCB,
+                  uint32_t dpuPageBlkCnt,
+                  const std::vector<CPU_TCB> &reduceTCBs, Task &cpuTask,
+                  Task &reduceTask) noexcept;
+
   // Generic worker function for processing tasks from a queue
   void processTasks(
       std::queue<Task> &queue, std::vector<completeSgn> &completedVector,
@@ -121,35 +200,203 @@ private:
                                        OperatorType opType,
                                        const CPU_TCB &cpuTCB,
                                        const DPU_TCB &dpuTCB,
-                                       execType eT) noexcept;
+                                       execType eT,
+                                       uint32_t fusedStageNum = 0,
+                                       uint32_t dpuChainStageNum = 0,
+                                       int elemType = INT32_32ALN) noexcept;
+
+  // Chains of element-wise nodes whose CPU shares line up and whose links
+  // move nothing, each node is mapped to the head of its chain, -1 when it
+  // is not part of a chain of two or more. Their CPU shares run as one pass.
+  std::vector<int>
+  planElemwiseFusion(const TaskGraph &g, const Schedule &sched,
+                     const std::vector<uint32_t> &cpuPageBlkCnts,
+                     const std::vector<uint32_t> &dpuPageBlkCnts)
+      const noexcept;
+
+  // Maximal chains of CPU-only compute nodes and fused element-wise chains,
+  // each node is mapped to the head of its chain, -1 when it is not part of
+  // a chain of two or more.
+  std::vector<int> planCPURegions(const TaskGraph &g, const Schedule &sched,
+                                  const std::vector<int> &fusedHead)
+      const noexcept;
+
+  // Apply every operator of a chain to one L2-sized tile before moving on,
+  // so intermediates stay in cache instead of round-tripping DRAM. Fused
+  // runs never write their intermediates at all.
+  void execCPURegion(const std::vector<regionOp> &region) const noexcept;
+
+  // Broadcast operands get a range of the broadcast region per producer,
+  // shared by all its broadcast consumers. Operands that do not fit fall
+  // back to the regular scatter.
+  void planBroadcasts(const TaskGraph &g, const Schedule &sched,
+                      const std::vector<uint32_t> &dpuPageBlkCnts) noexcept;
+
+  // Data-dependent operators whose DPU share goes through the host both
+  // ways get a slot map, balanced from the pages right before they are
+  // mapped. Only DO mode has pages to look at.
+  void planSkewPartitions(const TaskGraph &g, const Schedule &sched,
+                          const std::vector<uint32_t> &dpuPageBlkCnts) noexcept;
+  void balanceSkewPartition(int taskId, OperatorTag opTag,
+                            const char *hostBasePtr) noexcept;
+
+  // Same-tag DPU shares of one stage are packed into disjoint MRAM ranges
+  // and launched once from the slot of their last member. Fills the batch
+  // bookkeeping and returns schedule positions in queue order.
+  std::vector<size_t>
+  planDPUBatches(const TaskGraph &g, const Schedule &sched,
+                 const std::vector<uint32_t> &dpuPageBlkCnts) noexcept;
+
+  // Chains of DPU shares whose links move nothing, run as one launch from
+  // the head: each node is mapped to the head of its chain, -1 when it is
+  // not part of a chain of two or more. Members launch through their head.
+  std::vector<int>
+  planDPUChains(const TaskGraph &g, const Schedule &sched,
+                const std::vector<uint32_t> &dpuPageBlkCnts) noexcept;
+
+  // Content key of every node output, 0 when it cannot be memoized. Keys
+  // chain through producers, only the graph inputs are hashed.
+  std::vector<uint64_t> keyOutputs(const TaskGraph &g,
+                                   const Schedule &sched) const noexcept;
+
+  // Copy the output of a DO-mode miss into the cache as its shares land.
+  void attachCacheFill(uint64_t key, uint32_t cpuPageBlkCnt,
+                       uint32_t dpuPageBlkCnt, const CPU_TCB &cpuTCB,
+                       const std::vector<CPU_TCB> &reduceTCBs, Task &cpuTask,
+                       Task &reduceTask) noexcept;
 
   std::pair<Task, Task> genXferTask(int taskId, OperatorTag opTag,
-                                    const CPU_TCB &mapTCB,
-                                    const CPU_TCB &reduceTCB,
+                                    const std::vector<CPU_TCB> &mapTCBs,
+                                    const std::vector<CPU_TCB> &reduceTCBs,
+                                    double compressRatio,
                                     execType eT) noexcept;
 
-  std::tuple<CPU_TCB,DPU_TCB,CPU_TCB,CPU_TCB> memPlan(const TaskGraph& g, int i,
-                                                            uint32_t cpuPageBlkCnt,
-                                                            uint32_t dpuPageBlkCnt,
-                                                            uint32_t mapPageBlkCnt,
-                                                            uint32_t reducePageBlkCnt){
+  // Per-edge MAP/REDUCE volume of a producer, in page blocks.
+  typedef struct edgeXfer {
+    TaskNode succ;
+    uint32_t mapPageBlkCnt = 0;
+    uint32_t reducePageBlkCnt = 0;
+  } edgeXfer;
+
+  std::vector<edgeXfer> planEdgeXfer(const TaskGraph &g, const Schedule &sched,
+                                     int taskId,
+                                     float offloadRatio) const noexcept;
+
+  // Every edge reads a prefix of the same producer output, so edge
+  // descriptors only carry the pages their shorter siblings have not moved.
+  std::vector<CPU_TCB> edgeSgPlan(char *heapBasePtr, uint32_t dpuPageBaseIdx,
+                                  std::vector<uint32_t> pageBlkCnts,
+                                  const uint32_t *dpuSlot = nullptr) const noexcept{
+   std::sort(pageBlkCnts.begin(), pageBlkCnts.end());
+   std::vector<CPU_TCB> tcbs;
+   uint32_t movedPageBlkCnt = 0;
+   for (const uint32_t pageBlkCnt : pageBlkCnts) {
+     if (pageBlkCnt <= movedPageBlkCnt)
+       continue;
+     CPU_TCB tcb;
+     tcb.sgInfo = {heapBasePtr + (size_t)movedPageBlkCnt * om.getPageBlkSize(),
+                   dpuPageBaseIdx + movedPageBlkCnt,
+                   pageBlkCnt - movedPageBlkCnt};
+     if (dpuSlot != nullptr)
+       tcb.sgInfo.dpuSlot = dpuSlot + (size_t)movedPageBlkCnt *
+                                          (om.getPageBlkSize() / PAGE_SIZE_BYTE);
+     tcbs.push_back(tcb);
+     movedPageBlkCnt = pageBlkCnt;
+   }
+   return tcbs;
+  }
+
+  // Host pages a node reads from: the bound dataset for LOGIC_START and its
+  // successors, the pool for everything else.
+  char *inputBasePtr(const TaskGraph &g, int taskId) const noexcept {
+   if (dataset == nullptr || !dataset->isValid())
+     return (char *)memPoolPtr[0];
+   if (g.g[taskId].op == OperatorTag::LOGIC_START)
+     return (char *)dataset->data();
+   auto inEdges = boost::in_edges(taskId, g.g);
+   for (auto ei = inEdges.first; ei != inEdges.second; ++ei) {
+     if (g.g[boost::source(*ei, g.g)].op == OperatorTag::LOGIC_START)
+       return (char *)dataset->data();
+   }
+   return (char *)memPoolPtr[0];
+  }
+
+  // Host pages a node's MAPs read from: its input for LOGIC_START, its
+  // output everywhere else.
+  char *mapBasePtr(const TaskGraph &g, int taskId) const noexcept {
+   return g.g[taskId].op == OperatorTag::LOGIC_START ? inputBasePtr(g, taskId)
+                                                     : (char *)memPoolPtr[0];
+  }
+
+  const uint32_t *dpuSlotOf(int taskId) const noexcept {
+   return dpuSlot_[taskId].empty() ? nullptr : dpuSlot_[taskId].data();
+  }
+
+  std::tuple<CPU_TCB,DPU_TCB,std::vector<CPU_TCB>,std::vector<CPU_TCB>>
+  memPlan(const TaskGraph& g, int taskId, uint32_t cpuPageBlkCnt,
+          uint32_t dpuPageBlkCnt, const std::vector<uint32_t> &mapPageBlkCnts,
+          const std::vector<uint32_t> &mapDPUPageBaseIdxs,
+          const std::vector<const uint32_t *> &mapDPUSlots,
+          const std::vector<uint32_t> &reducePageBlkCnts){
    char* heapBasePtr = (char*)memPoolPtr[0];
-   uint32_t dpuPageBaseIdx = 0;
-   CPU_TCB cpuTCB{heapBasePtr, 
+   char* inputPtr = inputBasePtr(g, taskId);
+   uint32_t dpuPageBaseIdx = dpuPageBaseIdx_[taskId];
+   // Batch members interleave with their siblings: every src1 range first,
+   // then every src2 range, then every dst range.
+   uint32_t dpuRegionPageCnt =
+       dpuBatchPageCnt_[taskId] ? dpuBatchPageCnt_[taskId] : dpuPageBlkCnt;
+   // Mapped datasets are read-only, the DPU share is their head and the CPU
+   // reads the rest in place.
+   CPU_TCB cpuTCB{inputPtr == heapBasePtr
+                      ? heapBasePtr
+                      : inputPtr + (size_t)dpuPageBlkCnt * om.getPageBlkSize(),
                   heapBasePtr + cpuPageBlkCnt * om.getPageBlkSize(),
                   heapBasePtr + 2 * cpuPageBlkCnt * om.getPageBlkSize(),
                   cpuPageBlkCnt};
    DPU_TCB dpuTCB{dpuPageBaseIdx,
-                  dpuPageBaseIdx + dpuPageBlkCnt,
-                  dpuPageBaseIdx + 2 * dpuPageBlkCnt,
+                  dpuPageBaseIdx + dpuRegionPageCnt,
+                  dpuPageBaseIdx + 2 * dpuRegionPageCnt,
                   dpuPageBlkCnt};
-   CPU_TCB mapTCB;    mapTCB.sgInfo =   {heapBasePtr, dpuPageBaseIdx, mapPageBlkCnt}; 
-   CPU_TCB reduceTCB; reduceTCB.sgInfo ={heapBasePtr, dpuPageBaseIdx, reducePageBlkCnt};
-   return {cpuTCB, dpuTCB, mapTCB, reduceTCB};
+   char* mapPtr = mapBasePtr(g, taskId);
+   // Consumers sharing an MRAM range and page order share prefixes, batched
+   // and skew-balanced ones have their own.
+   std::map<std::pair<uint32_t, const uint32_t *>, std::vector<uint32_t>>
+       mapPageBlkCntsByBase;
+   for (size_t j = 0; j < mapPageBlkCnts.size(); ++j) {
+     mapPageBlkCntsByBase[{mapDPUPageBaseIdxs[j], mapDPUSlots[j]}].push_back(
+         mapPageBlkCnts[j]);
+   }
+   std::vector<CPU_TCB> mapTCBs;
+   for (const auto &[mapDst, pageBlkCnts] : mapPageBlkCntsByBase) {
+     auto tcbs =
+         edgeSgPlan(mapPtr, mapDst.first, pageBlkCnts, mapDst.second);
+     mapTCBs.insert(mapTCBs.end(), tcbs.begin(), tcbs.end());
+   }
+   if (bcastPageCnt_[taskId]) {
+     CPU_TCB bcastTCB;
+     bcastTCB.sgInfo = {mapPtr, bcastPageIdx_[taskId],
+                        bcastPageCnt_[taskId]};
+     bcastTCB.sgInfo.isBroadcast = true;
+     mapTCBs.push_back(bcastTCB);
+   }
+   // A broadcast src2 is read from the host copy that was broadcast.
+   if (const int pred = bcastPred_[taskId]; pred >= 0) {
+     cpuTCB.src2PageBase = mapBasePtr(g, pred);
+     cpuTCB.src2Wrap_Byte = (size_t)src2WrapPageCnt_[taskId] * PAGE_SIZE_BYTE;
+     cpuTCB.src2Phase_Byte = (size_t)dpuPageBlkCnt * om.getPageBlkSize();
+     dpuTCB.src2PageIdx = bcastPageIdx_[pred];
+     dpuTCB.src2WrapPageCnt = src2WrapPageCnt_[taskId];
+   }
+   return {cpuTCB, dpuTCB, mapTCBs,
+           edgeSgPlan(heapBasePtr, dpuPageBaseIdx, reducePageBlkCnts,
+                      dpuSlotOf(taskId))};
    }
 
 private:
   void** memPoolPtr;
+  const DatasetSource *dataset = nullptr;
+  ResultSink *sink = nullptr;
+  OutputCache *outputCache = nullptr;
   int memPoolNum = 3;
   double totalDPUTime_Second = 0.0f;
   const OperatorManager &om;
@@ -157,6 +404,25 @@ private:
   std::mutex dpuMutex_;
   std::condition_variable cv_;
   std::vector<std::vector<int>> dependencies_;
+  // Position of every task in the schedule order, set first by parseGraph.
+  std::vector<size_t> orderPos_;
+  // DPU launch bookkeeping, identical to the plain graph unless batched.
+  std::vector<std::vector<int>> dpuDependencies_;
+  std::vector<int> dpuLauncher_;
+  std::vector<uint32_t> dpuPageBaseIdx_;
+  std::vector<uint32_t> dpuBatchPageCnt_; // 0 when launched alone
+  // Broadcast region range of a producer, 0 pages when not broadcast.
+  std::vector<uint32_t> bcastPageIdx_;
+  std::vector<uint32_t> bcastPageCnt_;
+  // Producer of a consumer's broadcast src2, -1 when src2 is scattered.
+  std::vector<int> bcastPred_;
+  std::vector<uint32_t> src2WrapPageCnt_;
+  // Host slot of every (page block, DPU) of a skew-balanced DPU share,
+  // empty for round-robin. Sized at planning, filled in place by the MAP.
+  std::vector<std::vector<uint32_t>> dpuSlot_;
+  std::unordered_map<int, std::vector<uint64_t>> dpuFinishCycles_;
+  std::unordered_map<int, int64_t> dpuReductions_;
+  std::vector<bool> isOutputCached_;
 
   std::vector<completeSgn> cpuCompleted_, dpuCompleted_, mapCompleted_,
       reduceCompleted_;
@@ -10,6 +10,7 @@
 #ifndef TASK_HPP
 #define TASK_HPP
 #include "Operator/OperatorRegistry.hpp"
+#include "utils/Consensus.h"
 #include <boost/graph/adjacency_list.hpp>
 #include <map>
 #include <string>
@@ -37,6 +38,12 @@ typedef struct TaskProperties {
   bool isDPUOnly = false;
   double offloadRatio = 0.0f;
   // ----- Schedule adjust zone ------
+  // Expected packed/raw size of this node's output, set by the caller and
+  // never measured. 1.0 disables the codec.
+  double xferCompressRatio = 1.0f;
+  // Consensus type tag of the elements, see Operator::elemType2Suffix. Last,
+  // so positional initializers of the fields above keep working.
+  int elemType = INT32_32ALN;
 } TaskProperties;
 
 } // namespace Executor
@@ -30,7 +30,9 @@ public:
   void traverse();
   // -----------MetaPB related functions -----------
   // Generate regression task according to op set and batch size.
-  regressionTask genRegressionTask();
+  regressionTask genRegressionTask() const;
+  // Consensus type tags of the nodes, each typed operator is modeled per type.
+  std::set<int> genElemTypes() const;
   // Using regression model to predict the performance metrics
   // of a specific schedule, batchSize_MiB.
   perfStats deduceMetrics(const Schedule &, size_t);
@@ -39,6 +41,7 @@ public:
 
   // -----------MetaPB related functions -----------
   void printGraph(const std::string &filePath) const noexcept;
+  inline const std::string &getName() const noexcept { return name; }
   std::vector<int> topoSort() const noexcept;
 
   Graph g;
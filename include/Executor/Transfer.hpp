@@ -10,6 +10,10 @@ typedef struct TransferProperties {
   double prevDRAMRatio = 1.0f;
   double nextDRAMRatio = 1.0f;
   // ----- Schedule adjust zone ------
+  // Read-only operand every DPU reads whole, e.g. a query vector or weights.
+  // Sent once to all DPUs when it fits the broadcast region. Last, so the
+  // positional {ratio, isNeedTransfer} initializers keep their meaning.
+  bool isBroadcast = false;
 } TransferProperties;
 
 } // namespace Executor
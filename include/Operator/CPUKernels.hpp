@@ -0,0 +1,68 @@
+#ifndef CPU_KERNELS_HPP
+#define CPU_KERNELS_HPP
+
+#include "Operator/ConvKernel.hpp"
+#include "Operator/ElemwiseKernel.hpp"
+#include "Operator/FilterKernel.hpp"
+#include "Operator/ReduceKernel.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Set to scalar, avx2 or avx512 to pin the CPU kernels, e.g. to compare
+// variants. A variant the host cannot run falls back to the widest it can.
+#define CPU_ISA_ENV "METAPB_CPU_ISA"
+
+namespace MetaPB {
+namespace Operator {
+
+// Ordered by width, a host running one runs every narrower one.
+enum class CPUISA { SCALAR, AVX2, AVX512 };
+
+/// @brief Entry points of the hot CPU kernels, one table per ISA variant.
+typedef struct CPUKernelTable {
+  void (*elemwiseSpan)(const ElemwiseKind kind, const int elemType,
+                       const char *src1, const char *src2, char *dst,
+                       const size_t span_Byte,
+                       const std::function<size_t(size_t)> &src2Offset_Byte,
+                       const float weight);
+  void (*elemwiseFusedSpan)(const char *src1, char *dst,
+                            const size_t span_Byte,
+                            const std::vector<ElemwiseStage> &stages);
+  conv1DChunkFn (*selectConv1DChunk)(const int kernelSize);
+  // Windowed average of FILTER_KERNEL_SIZE.
+  void (*filterChunk)(const int *src, int *dst, const int itemNum);
+  int (*macChunk)(const int *a, const int *b, const uint32_t itemNum);
+  int (*eudistChunk)(const int *a, const int *b, const uint32_t itemNum);
+  int (*countChunk)(const int *src, const int target,
+                    const uint32_t itemNum);
+  int64_t (*combinePartials)(const int64_t *partials,
+                             const uint32_t partialNum);
+} CPUKernelTable;
+
+// Built once per variant by src/Operator/isa/CPUKernelTable.cpp.
+namespace scalar {
+const CPUKernelTable &getCPUKernelTable() noexcept;
+}
+namespace avx2 {
+const CPUKernelTable &getCPUKernelTable() noexcept;
+}
+namespace avx512 {
+const CPUKernelTable &getCPUKernelTable() noexcept;
+}
+
+/// @brief Widest ISA the host runs, or the one CPU_ISA_ENV asks for.
+/// Resolved once per process.
+CPUISA getCPUISA() noexcept;
+
+/// @brief Name CPU_ISA_ENV takes for isa, also tags the model caches.
+const std::string &getCPUISAName(const CPUISA isa) noexcept;
+
+/// @brief Kernels of getCPUISA().
+const CPUKernelTable &getCPUKernels() noexcept;
+
+} // namespace Operator
+} // namespace MetaPB
+#endif
@@ -0,0 +1,100 @@
+#ifndef CONV_KERNEL_HPP
+#define CONV_KERNEL_HPP
+
+#include "Operator/KernelISA.hpp"
+#include <cstdint>
+
+namespace MetaPB {
+namespace Operator {
+
+typedef void (*conv1DChunkFn)(const int *, int *, const int *, const int);
+
+inline namespace METAPB_KERNEL_ISA {
+
+/// @brief One output of a zero-padded convolution, taps falling outside
+/// [0, itemNum) are skipped.
+inline int conv1DItemBounded(const int *src, const int *taps,
+                             const int kernelSize, const int i,
+                             const int itemNum) noexcept {
+  const int padding = (kernelSize - 1) / 2;
+  int sum = 0;
+  for (int j = 0; j < kernelSize; ++j) {
+    const int inputIndex = i - padding + j;
+    if (inputIndex >= 0 && inputIndex < itemNum) {
+      sum += src[inputIndex] * taps[j];
+    }
+  }
+  return sum;
+}
+
+/// @brief Any kernel size, the bounds are checked on every tap.
+inline void conv1DChunkGeneric(const int *src, int *dst, const int *taps,
+                               const int kernelSize,
+                               const int itemNum) noexcept {
+  for (int i = 0; i < itemNum; ++i) {
+    dst[i] = conv1DItemBounded(src, taps, kernelSize, i, itemNum);
+  }
+}
+
+/// @brief Kernel size fixed at compile time: only the first and last few
+/// outputs see the padding, the interior runs without bounds checks, 16
+/// outputs per step with AVX-512.
+template <int K>
+inline void conv1DChunk(const int *src, int *dst, const int *taps,
+                        const int itemNum) noexcept {
+  constexpr int padding = (K - 1) / 2;
+  const int interiorEnd = itemNum - (K - 1 - padding);
+  const int headEnd = padding < itemNum ? padding : itemNum;
+  for (int i = 0; i < headEnd; ++i) {
+    dst[i] = conv1DItemBounded(src, taps, K, i, itemNum);
+  }
+
+  int i = padding;
+#ifdef METAPB_KERNEL_AVX512
+  __m512i vTaps[K];
+  for (int j = 0; j < K; ++j) {
+    vTaps[j] = _mm512_set1_epi32(taps[j]);
+  }
+  for (; i + 16 <= interiorEnd; i += 16) {
+    __m512i sum = _mm512_setzero_si512();
+    for (int j = 0; j < K; ++j) {
+      const __m512i window = _mm512_loadu_si512(src + i - padding + j);
+      sum = _mm512_add_epi32(sum, _mm512_mullo_epi32(window, vTaps[j]));
+    }
+    _mm512_storeu_si512(dst + i, sum);
+  }
+#endif
+  for (; i < interiorEnd; ++i) {
+    int sum = 0;
+    for (int j = 0; j < K; ++j) {
+      sum += src[i - padding + j] * taps[j];
+    }
+    dst[i] = sum;
+  }
+
+  for (i = interiorEnd < padding ? padding : interiorEnd; i < itemNum; ++i) {
+    dst[i] = conv1DItemBounded(src, taps, K, i, itemNum);
+  }
+}
+
+/// @brief Resolve the chunk kernel once per call, not per chunk. Null when
+/// the size has no specialisation, conv1DChunkGeneric then takes it.
+inline conv1DChunkFn selectConv1DChunk(const int kernelSize) noexcept {
+  switch (kernelSize) {
+  case 3:
+    return &conv1DChunk<3>;
+  case 5:
+    return &conv1DChunk<5>;
+  case 7:
+    return &conv1DChunk<7>;
+  case 8:
+    return &conv1DChunk<8>;
+  default:
+    return nullptr;
+  }
+}
+
+} // namespace METAPB_KERNEL_ISA
+} // namespace Operator
+} // namespace MetaPB
+#endif
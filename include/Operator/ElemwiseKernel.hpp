@@ -0,0 +1,242 @@
+#ifndef ELEMWISE_KERNEL_HPP
+#define ELEMWISE_KERNEL_HPP
+
+extern "C" {
+#include "Operator/dpu/common.h"
+}
+#include "Operator/KernelISA.hpp"
+#include "utils/Consensus.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <omp.h>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+// Used when the LLC size cannot be queried.
+#define CPU_LLC_FALLBACK_BYTE (32 << 20)
+
+namespace MetaPB {
+namespace Operator {
+
+enum class ElemwiseKind { ADD, PROD, AFFINE };
+
+/// @brief One operator of a fused chain, applied to the running value and
+/// its own src2.
+typedef struct ElemwiseStage {
+  ElemwiseKind kind = ElemwiseKind::ADD;
+  int weight = 0;
+  const char *src2 = nullptr;
+  std::function<size_t(size_t)> src2Offset_Byte;
+} ElemwiseStage;
+
+inline namespace METAPB_KERNEL_ISA {
+
+template <ElemwiseKind kind, typename T = int>
+inline T elemwiseItem(const T a, const T b, const T weight) noexcept {
+  if constexpr (kind == ElemwiseKind::ADD) {
+    return a + b;
+  } else if constexpr (kind == ElemwiseKind::PROD) {
+    return a * b;
+  } else {
+    return a * weight + b;
+  }
+}
+
+/// @brief Reference path, also used for the tail of a vector loop.
+template <ElemwiseKind kind, typename T = int>
+inline void elemwiseChunkScalar(const T *a, const T *b, T *dst,
+                                const uint32_t itemNum,
+                                const T weight) noexcept {
+  for (uint32_t i = 0; i < itemNum; i++) {
+    dst[i] = elemwiseItem<kind>(a[i], b[i], weight);
+  }
+}
+
+/// @brief One chunk, 16 items per step. Streaming stores need dst 64-byte
+/// aligned and bypass the cache, the caller fences. Other element types take
+/// the scalar loop and are left to the compiler's vectoriser.
+template <ElemwiseKind kind, bool isStreaming, typename T = int>
+inline void elemwiseChunk(const T *a, const T *b, T *dst,
+                          const uint32_t itemNum, const T weight) noexcept {
+  uint32_t i = 0;
+#ifdef METAPB_KERNEL_AVX512
+  if constexpr (std::is_same_v<T, int>) {
+    const __m512i w = _mm512_set1_epi32(weight);
+    for (; i + 16 <= itemNum; i += 16) {
+      const __m512i va = _mm512_loadu_si512(a + i);
+      const __m512i vb = _mm512_loadu_si512(b + i);
+      __m512i vd;
+      if constexpr (kind == ElemwiseKind::ADD) {
+        vd = _mm512_add_epi32(va, vb);
+      } else if constexpr (kind == ElemwiseKind::PROD) {
+        vd = _mm512_mullo_epi32(va, vb);
+      } else {
+        vd = _mm512_add_epi32(_mm512_mullo_epi32(va, w), vb);
+      }
+      if constexpr (isStreaming) {
+        _mm512_stream_si512((__m512i *)(dst + i), vd);
+      } else {
+        _mm512_storeu_si512(dst + i, vd);
+      }
+    }
+  }
+#endif
+  elemwiseChunkScalar<kind>(a + i, b + i, dst + i, itemNum - i, weight);
+}
+
+inline int elemwiseItemOf(const ElemwiseKind kind, const int a, const int b,
+                          const int weight) noexcept {
+  switch (kind) {
+  case ElemwiseKind::ADD:
+    return elemwiseItem<ElemwiseKind::ADD>(a, b, weight);
+  case ElemwiseKind::PROD:
+    return elemwiseItem<ElemwiseKind::PROD>(a, b, weight);
+  default:
+    return elemwiseItem<ElemwiseKind::AFFINE>(a, b, weight);
+  }
+}
+
+/// @brief One chunk through every stage, the running value stays in a
+/// register and only the last stage stores.
+template <bool isStreaming>
+inline void elemwiseFusedChunk(const int *a, const int *const *b, int *dst,
+                               const std::vector<ElemwiseStage> &stages,
+                               const uint32_t itemNum) noexcept {
+  uint32_t i = 0;
+#ifdef METAPB_KERNEL_AVX512
+  for (; i + 16 <= itemNum; i += 16) {
+    __m512i v = _mm512_loadu_si512(a + i);
+    for (size_t s = 0; s < stages.size(); s++) {
+      const __m512i vb = _mm512_loadu_si512(b[s] + i);
+      switch (stages[s].kind) {
+      case ElemwiseKind::ADD:
+        v = _mm512_add_epi32(v, vb);
+        break;
+      case ElemwiseKind::PROD:
+        v = _mm512_mullo_epi32(v, vb);
+        break;
+      default:
+        v = _mm512_add_epi32(
+            _mm512_mullo_epi32(v, _mm512_set1_epi32(stages[s].weight)), vb);
+      }
+    }
+    if constexpr (isStreaming) {
+      _mm512_stream_si512((__m512i *)(dst + i), v);
+    } else {
+      _mm512_storeu_si512(dst + i, v);
+    }
+  }
+#endif
+  for (; i < itemNum; i++) {
+    int v = a[i];
+    for (size_t s = 0; s < stages.size(); s++) {
+      v = elemwiseItemOf(stages[s].kind, v, b[s][i], stages[s].weight);
+    }
+    dst[i] = v;
+  }
+}
+
+inline size_t getLLCSize_Byte() noexcept {
+  static const size_t llcSize_Byte = [] {
+    const long size_Byte = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    return size_Byte > 0 ? (size_t)size_Byte : (size_t)CPU_LLC_FALLBACK_BYTE;
+  }();
+  return llcSize_Byte;
+}
+
+/// @brief Element-wise kernel over span_Byte of a CPU share, chunk by chunk
+/// so src2 can be remapped per chunk. Each thread gets a contiguous run of
+/// chunks. Outputs larger than streamThreshold_Byte would only evict the
+/// inputs, they are streamed past the cache instead.
+template <ElemwiseKind kind, typename T = int, typename Src2OffsetFn>
+inline void elemwiseSpan(const char *src1, const char *src2, char *dst,
+                         const size_t span_Byte, Src2OffsetFn src2Offset_Byte,
+                         const T weight = 0,
+                         const size_t streamThreshold_Byte =
+                             getLLCSize_Byte()) noexcept {
+  const uint32_t chunkItemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
+  const bool isStreaming =
+      span_Byte > streamThreshold_Byte && (uintptr_t)dst % 64 == 0;
+
+  omp_set_num_threads(64);
+#pragma omp parallel
+  {
+#pragma omp for schedule(static)
+    for (size_t offset = 0; offset < span_Byte; offset += DPU_DMA_BFFR_BYTE) {
+      const T *mySrc1 = (const T *)(src1 + offset);
+      const T *mySrc2 = (const T *)(src2 + src2Offset_Byte(offset));
+      T *myDst = (T *)(dst + offset);
+      if (isStreaming) {
+        elemwiseChunk<kind, true>(mySrc1, mySrc2, myDst, chunkItemNum, weight);
+      } else {
+        elemwiseChunk<kind, false>(mySrc1, mySrc2, myDst, chunkItemNum,
+                                   weight);
+      }
+    }
+#ifdef METAPB_KERNEL_AVX512
+    // Streamed lines have to be globally visible before the task completes.
+    if (isStreaming)
+      _mm_sfence();
+#endif
+  }
+}
+
+#define ELEMWISE_SPAN(T, kind, src1, src2, dst, span_Byte, src2Offset_Byte,   \
+                      weight)                                                  \
+  elemwiseSpan<kind, T>(src1, src2, dst, span_Byte, src2Offset_Byte, (T)weight)
+
+/// @brief elemwiseSpan over elements of a Consensus type tag, the weight is
+/// converted the way the DPU kernel of that type converts it.
+template <ElemwiseKind kind, typename Src2OffsetFn>
+inline void elemwiseSpanOf(const int elemType, const char *src1,
+                           const char *src2, char *dst, const size_t span_Byte,
+                           Src2OffsetFn src2Offset_Byte,
+                           const float weight = 0) noexcept {
+  DO_GENERIC(elemType, ELEMWISE_SPAN, kind, src1, src2, dst, span_Byte,
+             src2Offset_Byte, weight);
+}
+
+/// @brief A chain of element-wise operators in one pass over span_Byte: src1
+/// and each stage's src2 are read once, only the chain output is written.
+inline void
+elemwiseFusedSpan(const char *src1, char *dst, const size_t span_Byte,
+                  const std::vector<ElemwiseStage> &stages,
+                  const size_t streamThreshold_Byte =
+                      getLLCSize_Byte()) noexcept {
+  const uint32_t chunkItemNum = DPU_DMA_BFFR_BYTE / sizeof(int);
+  const bool isStreaming =
+      span_Byte > streamThreshold_Byte && (uintptr_t)dst % 64 == 0;
+
+  omp_set_num_threads(64);
+#pragma omp parallel
+  {
+    std::vector<const int *> mySrc2s(stages.size());
+#pragma omp for schedule(static)
+    for (size_t offset = 0; offset < span_Byte; offset += DPU_DMA_BFFR_BYTE) {
+      for (size_t s = 0; s < stages.size(); s++) {
+        mySrc2s[s] =
+            (const int *)(stages[s].src2 + stages[s].src2Offset_Byte(offset));
+      }
+      const int *mySrc1 = (const int *)(src1 + offset);
+      int *myDst = (int *)(dst + offset);
+      if (isStreaming) {
+        elemwiseFusedChunk<true>(mySrc1, mySrc2s.data(), myDst, stages,
+                                 chunkItemNum);
+      } else {
+        elemwiseFusedChunk<false>(mySrc1, mySrc2s.data(), myDst, stages,
+                                  chunkItemNum);
+      }
+    }
+#ifdef METAPB_KERNEL_AVX512
+    if (isStreaming)
+      _mm_sfence();
+#endif
+  }
+}
+
+} // namespace METAPB_KERNEL_ISA
+} // namespace Operator
+} // namespace MetaPB
+#endif
@@ -0,0 +1,49 @@
+#ifndef FILTER_KERNEL_HPP
+#define FILTER_KERNEL_HPP
+
+#include "Operator/KernelISA.hpp"
+
+namespace MetaPB {
+namespace Operator {
+inline namespace METAPB_KERNEL_ISA {
+
+/// @brief Windowed average over one chunk, dst[i] is the sum of
+/// src[i, min(i + K, itemNum)) divided once by K * K. A power-of-two divisor
+/// takes the AVX-512 path, 16 outputs per step, the rest of the chunk keeps
+/// a running sum so every output costs one add, one subtract and one divide.
+template <int K>
+inline void filterChunk(const int *src, int *dst, const int itemNum) noexcept {
+  constexpr int divisor = K * K;
+  int i = 0;
+#ifdef METAPB_KERNEL_AVX512
+  if constexpr ((divisor & (divisor - 1)) == 0) {
+    constexpr int shift = __builtin_ctz(divisor);
+    for (; i + 16 + K - 1 <= itemNum; i += 16) {
+      __m512i sum = _mm512_loadu_si512(src + i);
+      for (int j = 1; j < K; ++j) {
+        sum = _mm512_add_epi32(sum, _mm512_loadu_si512(src + i + j));
+      }
+      // Bias negative sums so the shift rounds toward zero like a divide.
+      const __m512i bias =
+          _mm512_srli_epi32(_mm512_srai_epi32(sum, 31), 32 - shift);
+      _mm512_storeu_si512(
+          dst + i, _mm512_srai_epi32(_mm512_add_epi32(sum, bias), shift));
+    }
+  }
+#endif
+  int sum = 0;
+  for (int j = i; j < i + K && j < itemNum; ++j) {
+    sum += src[j];
+  }
+  for (; i < itemNum; ++i) {
+    dst[i] = sum / divisor;
+    sum -= src[i];
+    if (i + K < itemNum)
+      sum += src[i + K];
+  }
+}
+
+} // namespace METAPB_KERNEL_ISA
+} // namespace Operator
+} // namespace MetaPB
+#endif
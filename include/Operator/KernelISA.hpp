@@ -0,0 +1,21 @@
+#ifndef KERNEL_ISA_HPP
+#define KERNEL_ISA_HPP
+
+// Hot CPU kernels are compiled once per ISA by
+// src/Operator/isa/CPUKernelTable.cpp, which names the variant before
+// including them. Their functions live in an
+// inline namespace of that name, so the variants never merge at link time.
+// A plain include follows the compiler flags. A GCC target pragma does not
+// define __AVX512F__, so the kernels test METAPB_KERNEL_AVX512 instead.
+#ifndef METAPB_KERNEL_ISA
+#define METAPB_KERNEL_ISA native
+#ifdef __AVX512F__
+#define METAPB_KERNEL_AVX512 1
+#endif
+#endif
+
+#ifdef METAPB_KERNEL_AVX512
+#include <immintrin.h>
+#endif
+
+#endif
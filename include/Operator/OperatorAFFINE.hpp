@@ -4,6 +4,7 @@
 extern "C" {
 #include "Operator/dpu/AFFINE.h"
 }
+#include "Operator/CPUKernels.hpp"
 #include "Operator/OperatorBase.hpp"
 
 namespace MetaPB {
@@ -11,8 +12,9 @@ namespace Operator {
 
 class OperatorAFFINE : public OperatorBase {
 public:
-  OperatorAFFINE(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR)
-      : OperatorBase(g_DPU_MGR) {}
+  OperatorAFFINE(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR,
+                 const int elemType = INT32_32ALN)
+      : OperatorBase(g_DPU_MGR, elemType) {}
 
   inline virtual const std::string get_name() const noexcept override {
     return OpName;
@@ -29,6 +31,32 @@ public:
   virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
     return false;
   }
+  // 1: vectorised CPU path with streaming stores.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept
+      override {
+    return 1;
+  }
+  virtual inline bool
+  getElemwiseStage(const CPU_TCB &cpuTCB,
+                   ElemwiseStage &stage) const noexcept override {
+    if (elemType != INT32_32ALN) // the fused pass is int only
+      return false;
+    stage = {ElemwiseKind::AFFINE, (int)weight,
+             (const char *)cpuTCB.src2PageBase,
+             [this, cpuTCB](size_t offset) {
+               return getSrc2Offset_Byte(cpuTCB, offset);
+             }};
+    return true;
+  }
+  virtual inline bool
+  getDPUChainStage(const DPU_TCB &dpuTCB,
+                   chain_stage &stage) const noexcept override {
+    if (elemType != INT32_32ALN) // the chain program is int only
+      return false;
+    stage = {CHAIN_OP_AFFINE, dpuTCB.src2PageIdx, dpuTCB.src2WrapPageCnt,
+             (int)weight};
+    return true;
+  }
 
 private:
   const float weight = 2.5f;
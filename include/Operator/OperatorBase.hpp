@@ -10,10 +10,12 @@
 
 #define BATCH_LOWERBOUND_MB 128
 //#define PERF_SAMPLE_POINT 16
+#define DPU_VARIANT_TUNE_POINT 4 // sizes every DPU kernel variant is timed at
 #define PERF_SAMPLE_POINT 16
 #define REGRESSION_TRAINING_ITER 200
 #define REGRESSION_MODEL_CACHE_PATH "/tmp/MetaPB/perfModel/"
 #define DPU_ENERGY_CONSTANT_PER_SEC 280.0
+#define DPU_ENERGY_REFERENCE_DPU_NUM 2530 // DPUs lit when the above was measured
 
 #ifndef PAGE_SIZE_BYTE
 #define PAGE_SIZE_BYTE 4096
@@ -23,6 +25,10 @@
 #define roundup(n, m) ((n / m) * m + m)
 
 #include "DPU_GLOBAL.hpp"
+#include "Operator/OperatorRegistry.hpp"
+extern "C" {
+#include "Operator/dpu/ELEW_FUSED.h"
+}
 #include "omp.h"
 #include "utils/CSVWriter.hpp"
 #include "utils/ChronoTrigger.hpp"
@@ -44,10 +50,18 @@ using perfStats = utils::perfStats;
 using Learner = utils::Learner;
 using ChronoTrigger = utils::ChronoTrigger;
 
+struct ElemwiseStage;
+
 typedef struct sg_xfer_context {
   void *cpuPageBlkBaseAddr; // target cpu page block base address
   uint32_t dpuPageBaseIdx = 0;
   uint32_t pageBlkCnt = 0;
+  bool isPacked = false; // move through XferCodec instead of raw pages
+  uint32_t dpuNum = 0;   // pages per page block, set by the transferring op
+  bool isBroadcast = false; // pageBlkCnt pages, sent whole to every DPU
+  // Host slot inside its page block of every (page block, DPU), block
+  // major. Round-robin when null.
+  const uint32_t *dpuSlot = nullptr;
 } sg_xfer_context;
 
 typedef struct CPU_TCB {
@@ -59,6 +73,12 @@ typedef struct CPU_TCB {
   // Scatter-Gather Xfer related metadata
   // For MAP and REDUCE only
   sg_xfer_context sgInfo;
+  // Bytes of one cache tile from the page bases, 0 means all page blocks.
+  size_t tileSize_Byte = 0;
+  // A broadcast src2 is read the way every DPU reads its copy: wrapping at
+  // src2Wrap_Byte, src2Phase_Byte is the node output ahead of this share.
+  size_t src2Wrap_Byte = 0;
+  size_t src2Phase_Byte = 0;
 } CPU_TCB;
 
 typedef struct DPU_TCB {
@@ -66,12 +86,14 @@ typedef struct DPU_TCB {
   unsigned int src2PageIdx;
   unsigned int dstPageIdx;
   unsigned int pageCnt;
+  unsigned int src2WrapPageCnt = 0; // broadcast src2 length, 0 if not
   DPU_TCB &operator=(const DPU_TCB &other) {
     if (this != &other) {
       this->src1PageIdx = other.src1PageIdx;
       this->src2PageIdx = other.src2PageIdx;
       this->dstPageIdx = other.dstPageIdx;
       this->pageCnt = other.pageCnt;
+      this->src2WrapPageCnt = other.src2WrapPageCnt;
     }
     return *this;
   }
@@ -80,10 +102,10 @@ typedef struct DPU_TCB {
 /// @brief This class is the uniformed interface of all operator.
 class OperatorBase {
 public:
-  OperatorBase(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR)
-      : allDPUs(g_DPU_MGR->dpu_set), dpuNum(2530),
-        pageBlkSize(dpuNum * PAGE_SIZE_BYTE) {
-        }
+  OperatorBase(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR,
+               const int elemType = INT32_32ALN)
+      : allDPUs(g_DPU_MGR->dpu_set), dpuNum(g_DPU_MGR->getDPUNum()),
+        pageBlkSize(dpuNum * PAGE_SIZE_BYTE), elemType(elemType) {}
 
   inline virtual void execCPU(const CPU_TCB &cpuTCB) const noexcept = 0;
   inline virtual void execDPU(const DPU_TCB &dpuTCB) const noexcept = 0;
@@ -93,6 +115,9 @@ public:
   perfStats execDPUwithProbe(const DPU_TCB &dpuTCB) noexcept;
 
   void trainModel(const uint32_t pageUpperBound) noexcept;
+  /// @brief Times every built variant of the DPU kernel at sizes up to
+  /// pageUpperBound and keeps the fastest, saved next to the model cache.
+  void tuneDPUVariant(const uint32_t pageUpperBound) noexcept;
 
   /// @brief All our deducing has a finest granular -- page block, which
   /// consists of dpuNum x 4K Pages
@@ -144,22 +169,115 @@ public:
   }
 
   std::string getDPUBinaryPath() const noexcept;
+  std::string getDPUBinaryPath(const std::string &binaryName) const noexcept;
+  /// @brief Resolved once per process, safe to warm from another thread.
+  static const std::string &getDPUBinaryDir() noexcept;
   inline virtual const std::string get_name() const noexcept = 0;
   inline virtual constexpr int getInputTensorNum() const noexcept = 0;
   virtual inline constexpr bool checkIfIsTrainable() const noexcept = 0;
   virtual inline constexpr bool checkIfIsCPUOnly() const noexcept = 0;
+  /// @brief Bumped when execCPU changes speed, so cached curves of the old
+  /// kernel are probed again instead of loaded.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept {
+    return 0;
+  }
   virtual inline const bool checkIfIsTrained() const noexcept {
     return isTrained;
   }
 
-  inline const uint32_t getPageBlkSize() const { 
-    std::cout << "Returned pageBlkSize = " << dpuNum << " x " << PAGE_SIZE_BYTE << " = "<< dpuNum * PAGE_SIZE_BYTE << std::endl;
-    return 2530*4096; }
+  inline const uint32_t getPageBlkSize() const noexcept { return pageBlkSize; }
+  /// @brief Binary suffix of the tuned DPU kernel variant, empty for the
+  /// default one.
+  inline const std::string &getDPUVariant() const noexcept {
+    return dpuVariant;
+  }
+  /// @brief False when the variant was picked on the emulator, its timings
+  /// say little about DPUs.
+  inline bool checkIfDPUVariantIsAuthoritative() const noexcept {
+    return isDPUVariantAuthoritative;
+  }
+  /// @brief Consensus type tag of the elements this instance runs on.
+  inline int getElemType() const noexcept { return elemType; }
+  /// @brief Appended to the DPU binary and model cache names, empty for int.
+  inline std::string getElemTypeSuffix() const noexcept {
+    const auto it = elemType2Suffix.find(elemType);
+    return it != elemType2Suffix.end() ? it->second : std::string();
+  }
+
+  /// @brief Relative DPU work of one input page, uniform unless the kernel
+  /// is data dependent. Must be cheap, it runs on every page of a transfer.
+  virtual inline float estimatePageCost(const void *page) const noexcept {
+    return 1.0f;
+  }
+  /// @brief This operator as one stage of a fused element-wise chain over
+  /// cpuTCB, false when it does not fuse.
+  virtual inline bool getElemwiseStage(const CPU_TCB &cpuTCB,
+                                       ElemwiseStage &stage) const noexcept {
+    return false;
+  }
+  /// @brief This operator as one stage of a chain launched as one DPU
+  /// program over dpuTCB, false when it does not chain.
+  virtual inline bool getDPUChainStage(const DPU_TCB &dpuTCB,
+                                       chain_stage &stage) const noexcept {
+    return false;
+  }
+  /// @brief Per page block, hand the heaviest page to the least loaded DPU.
+  /// Every DPU keeps one page per block, so prefixes of blocks stay valid.
+  static std::vector<uint32_t>
+  balanceDPUSlots(const std::vector<float> &pageCosts,
+                  const uint32_t dpuNum) noexcept;
+  /// @brief Cycles each DPU took in the last launch of a kernel that
+  /// reports them, empty otherwise.
+  inline const std::vector<uint64_t> &getDPUFinishCycles() const noexcept {
+    return dpuFinishCycles;
+  }
+  /// @brief Result of the DPU share of the last launch of a reduction, its
+  /// per-DPU partials combined on the host.
+  inline int64_t getDPUReduction() const noexcept { return dpuReduction; }
+  /// @brief Launch energy scales with the DPUs actually lit.
+  static inline double deduceDPUEnergy_Joule(const double time_Second,
+                                             const uint32_t dpuNum) noexcept {
+    return time_Second * DPU_ENERGY_CONSTANT_PER_SEC * dpuNum /
+           DPU_ENERGY_REFERENCE_DPU_NUM;
+  }
+  inline size_t getTrainedPageBlkUpperBound() const noexcept {
+    return deducePageBlkUpperBound;
+  }
+
+  /// @brief Filesystem only, no DPU is touched, so operators may load their
+  /// caches concurrently.
+  bool loadModelCacheIfExist(const uint32_t pageUpperBound) noexcept;
+
+  /// @brief Follow the active view after GLOBAL_DPU_MGR::useRanks(), which
+  /// narrows allDPUs in place. The model was fitted for the old geometry,
+  /// the next trainModel loads or probes the new one.
+  virtual void rebindDPUs(const GLOBAL_DPU_MGR &g_DPU_MGR) noexcept {
+    dpuNum = g_DPU_MGR.getDPUNum();
+    pageBlkSize = dpuNum * PAGE_SIZE_BYTE;
+    isTrained = false;
+  }
 
 protected:
   dpu_set_t &allDPUs;
-  const uint32_t dpuNum;
-  const uint32_t pageBlkSize;
+  uint32_t dpuNum;      // of the active view, see rebindDPUs()
+  uint32_t pageBlkSize;
+  const int elemType;
+  inline size_t getCPUSpan_Byte(const CPU_TCB &cpuTCB) const noexcept {
+    return cpuTCB.tileSize_Byte ? cpuTCB.tileSize_Byte
+                                : (size_t)cpuTCB.pageBlkCnt * pageBlkSize;
+  }
+  // Offset into src2 of the chunk at offset of src1. Host page blocks
+  // interleave the DPUs, a broadcast src2 is indexed by the page-local
+  // offset the owning DPU sees.
+  inline size_t getSrc2Offset_Byte(const CPU_TCB &cpuTCB,
+                                   const size_t offset) const noexcept {
+    if (cpuTCB.src2Wrap_Byte == 0)
+      return offset;
+    const size_t nodeOffset = cpuTCB.src2Phase_Byte + offset;
+    return ((nodeOffset / pageBlkSize) * PAGE_SIZE_BYTE +
+            nodeOffset % PAGE_SIZE_BYTE) %
+           cpuTCB.src2Wrap_Byte;
+  }
   inline static bool get_block(struct sg_block_info *out, uint32_t dpu_index,
                                uint32_t block_index, void *args) {
 
@@ -171,16 +289,35 @@ protected:
 
     out->length = PAGE_SIZE_BYTE;
 
+    const size_t slotIdx = (size_t)block_index * sgArgs->dpuNum + dpu_index;
+    const uint32_t slot =
+        sgArgs->dpuSlot ? sgArgs->dpuSlot[slotIdx] : dpu_index;
     out->addr = (uint8_t *)sgArgs->cpuPageBlkBaseAddr +
-                PAGE_SIZE_BYTE * (block_index * 2530 + dpu_index);
+                PAGE_SIZE_BYTE *
+                    ((size_t)block_index * sgArgs->dpuNum + slot);
     return true;
   }
+  // One uint64_t per DPU from offset_Byte of the stat page.
+  void gatherDPUStat(const uint32_t offset_Byte, uint64_t *dst) const noexcept;
+  // Read back the finish cycle a kernel left in the stat page.
+  void recordDPUFinishCycles() const noexcept;
+  mutable std::vector<uint64_t> dpuFinishCycles;
+  // Gather and combine the partials a reduction kernel left in the stat
+  // page, kilobytes instead of its output pages.
+  void recordDPUReduction() const noexcept;
+  mutable int64_t dpuReduction = 0;
 
 private:
   void savePerfSamples(const perfStats[],
                        const std::string &path) const noexcept;
   void loadPerfSamples(perfStats[], const std::string &path) const noexcept;
-  bool loadModelCacheIfExist(const uint32_t pageUpperBound) noexcept;
+  /// @brief Caches are only valid for the geometry they were probed on.
+  std::string modelCacheTag(const uint32_t pageUpperBound) const noexcept;
+  /// @brief Variants of this instance's DPU kernel, the default first.
+  std::vector<std::string> getDPUVariantsOfSelf() const noexcept;
+  void saveDPUVariant(const std::string &path,
+                      const double timeCost_Second) const noexcept;
+  bool loadDPUVariant(const std::string &path) noexcept;
 
   // storing all datasize to taskname
   std::map<float, std::string> cpuExecJob2Name;
@@ -192,7 +329,10 @@ private:
   perfStats CPUPerfSamples[PERF_SAMPLE_POINT + 1]; // +1 for lowerbound
   perfStats DPUPerfSamples[PERF_SAMPLE_POINT + 1];
 
-  inline static bool isTrained = false;
+  bool isTrained = false;
+
+  std::string dpuVariant;
+  bool isDPUVariantAuthoritative = true;
 
   ChronoTrigger ct;
 
@@ -0,0 +1,46 @@
+#ifndef OP_CODEC_HPP
+#define OP_CODEC_HPP
+
+#include "Operator/OperatorBase.hpp"
+#include "Operator/XferCodec.hpp"
+
+namespace MetaPB {
+namespace Operator {
+
+/// @brief Probe-only operator of the transfer codec, CPU side packs page
+/// blocks on host and DPU side unpacks raw-width pages. Packed MAP/REDUCE
+/// costs are composed from this model and the MAP/REDUCE models. Packing is
+/// only considered for tasks whose caller sets a TaskProperties
+/// xferCompressRatio below 1, the ratio is never measured from the data.
+class OperatorCODEC : public OperatorBase {
+public:
+  OperatorCODEC(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR)
+      : OperatorBase(g_DPU_MGR), codec(allDPUs, dpuNum) {}
+  inline virtual const std::string get_name() const noexcept override {
+    return OpName;
+  }
+  inline virtual constexpr int getInputTensorNum() const noexcept override {
+    return 1;
+  }
+  virtual void execCPU(const CPU_TCB &cpuTCB) const noexcept override;
+  virtual void execDPU(const DPU_TCB &dpuTCB) const noexcept override;
+
+  virtual inline constexpr bool checkIfIsTrainable() const noexcept override {
+    return true;
+  }
+  virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
+    return false;
+  }
+
+  virtual void rebindDPUs(const GLOBAL_DPU_MGR &g_DPU_MGR) noexcept override {
+    OperatorBase::rebindDPUs(g_DPU_MGR);
+    codec.rebind(dpuNum);
+  }
+
+private:
+  mutable XferCodec codec;
+  inline static const std::string OpName = "CODEC";
+};
+} // namespace Operator
+} // namespace MetaPB
+#endif
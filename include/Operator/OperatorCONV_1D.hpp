@@ -5,6 +5,7 @@ extern "C" {
 #include "Operator/dpu/CONV_1D.h"
 }
 
+#include "Operator/CPUKernels.hpp"
 #include "Operator/OperatorBase.hpp"
 
 using MetaPB::Operator::OperatorBase;
@@ -31,6 +32,11 @@ public:
   virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
     return false;
   }
+  // 1: kernel-size specialised sliding window.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept
+      override {
+    return 1;
+  }
 
 private:
   const int kernelSize = 8;
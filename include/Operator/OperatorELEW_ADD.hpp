@@ -1,6 +1,7 @@
 #ifndef OP_ELEW_ADD_HPP
 #define OP_ELEW_ADD_HPP
 
+#include "Operator/CPUKernels.hpp"
 #include "Operator/OperatorBase.hpp"
 extern "C" {
 #include "Operator/dpu/common.h"
@@ -13,8 +14,9 @@ namespace Operator {
 
 class OperatorELEW_ADD : public OperatorBase {
 public:
-  OperatorELEW_ADD(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR)
-      : OperatorBase(g_DPU_MGR) {}
+  OperatorELEW_ADD(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR,
+                   const int elemType = INT32_32ALN)
+      : OperatorBase(g_DPU_MGR, elemType) {}
   inline virtual const std::string get_name() const noexcept override {
     return OpName;
   }
@@ -31,6 +33,30 @@ public:
   virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
     return false;
   }
+  // 1: vectorised CPU path with streaming stores.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept
+      override {
+    return 1;
+  }
+  virtual inline bool
+  getElemwiseStage(const CPU_TCB &cpuTCB,
+                   ElemwiseStage &stage) const noexcept override {
+    if (elemType != INT32_32ALN) // the fused pass is int only
+      return false;
+    stage = {ElemwiseKind::ADD, 0, (const char *)cpuTCB.src2PageBase,
+             [this, cpuTCB](size_t offset) {
+               return getSrc2Offset_Byte(cpuTCB, offset);
+             }};
+    return true;
+  }
+  virtual inline bool
+  getDPUChainStage(const DPU_TCB &dpuTCB,
+                   chain_stage &stage) const noexcept override {
+    if (elemType != INT32_32ALN) // the chain program is int only
+      return false;
+    stage = {CHAIN_OP_ADD, dpuTCB.src2PageIdx, dpuTCB.src2WrapPageCnt, 0};
+    return true;
+  }
 
 private:
   inline static const std::string OpName = "ELEW_ADD";
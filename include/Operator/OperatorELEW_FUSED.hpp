@@ -0,0 +1,56 @@
+#ifndef OP_ELEW_FUSED_HPP
+#define OP_ELEW_FUSED_HPP
+
+extern "C" {
+#include "Operator/dpu/ELEW_FUSED.h"
+}
+#include "Operator/CPUKernels.hpp"
+#include "Operator/OperatorBase.hpp"
+#include <vector>
+
+// Stages of the probed chain: AFFINE, ELEW_ADD, ELEW_PROD.
+#define ELEW_FUSED_MODEL_STAGE_NUM 3
+
+namespace MetaPB {
+namespace Operator {
+
+/// @brief Fused element-wise chain, on the CPU as one pass over memory and
+/// on the DPU as one launch of a chain program. Both sides are probed on
+/// the same chain, other lengths are priced from it by the streams they
+/// touch, see OperatorManager::deducePerfFusedCPU and deducePerfFusedDPU.
+class OperatorELEW_FUSED : public OperatorBase {
+public:
+  OperatorELEW_FUSED(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR)
+      : OperatorBase(g_DPU_MGR) {}
+  inline virtual const std::string get_name() const noexcept override {
+    return OpName;
+  }
+  inline virtual constexpr int getInputTensorNum() const noexcept override {
+    return 2;
+  }
+  virtual void execCPU(const CPU_TCB &cpuTCB) const noexcept override;
+  virtual void execDPU(const DPU_TCB &dpuTCB) const noexcept override;
+  /// @brief One launch running stages in order on every chunk of the pages
+  /// of dpuTCB: src1 feeds the first stage, dst takes the last.
+  void execDPUChain(const DPU_TCB &dpuTCB,
+                    const std::vector<chain_stage> &stages) const noexcept;
+
+  virtual inline constexpr bool checkIfIsTrainable() const noexcept override {
+    return true;
+  }
+  virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
+    return false;
+  }
+  // 1: the DPU chain is probed too, older caches hold no DPU curve.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept
+      override {
+    return 1;
+  }
+
+private:
+  const float weight = 2.5f;
+  inline static const std::string OpName = "ELEW_FUSED";
+};
+} // namespace Operator
+} // namespace MetaPB
+#endif
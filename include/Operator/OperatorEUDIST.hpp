@@ -2,6 +2,7 @@
 #define OP_EUDIST_HPP
 
 #include "Operator/OperatorBase.hpp"
+#include "Operator/CPUKernels.hpp"
 #include "Operator/dpu/common.h"
 
 namespace MetaPB {
@@ -26,6 +27,17 @@ public:
   virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
     return false;
   }
+  // 1: multi-accumulator vector reduction.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept
+      override {
+    return 1;
+  }
+  virtual inline bool
+  getDPUChainStage(const DPU_TCB &dpuTCB,
+                   chain_stage &stage) const noexcept override {
+    stage = {CHAIN_OP_EUDIST, dpuTCB.src2PageIdx, dpuTCB.src2WrapPageCnt, 0};
+    return true;
+  }
 
 private:
   inline static const std::string OpName = "EUDIST";
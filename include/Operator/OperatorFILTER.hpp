@@ -5,6 +5,7 @@ extern "C" {
 #include "Operator/dpu/FILTER.h"
 }
 
+#include "Operator/CPUKernels.hpp"
 #include "Operator/OperatorBase.hpp"
 
 using MetaPB::Operator::OperatorBase;
@@ -31,9 +32,14 @@ public:
   virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
     return false;
   }
+  // 1: running-sum window with a single divide per output.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept
+      override {
+    return 1;
+  }
 
 private:
-  const int kernelSize = 8;
+  const int kernelSize = FILTER_KERNEL_SIZE;
   const int stride = 1;
   const float gaussianKernel[8] = {
       0.000872710786525902, 0.0175288647260302,   0.129521764811203,
@@ -5,6 +5,12 @@ extern "C" {
 #include "Operator/dpu/LOOKUP.h"
 }
 #include "Operator/OperatorBase.hpp"
+#include "Operator/CPUKernels.hpp"
+
+// Page cost sampling: every LOOKUP_COST_SAMPLE_STRIDE-th item is checked, a
+// hit costs LOOKUP_HIT_COST times a plain compare on the DPU.
+#define LOOKUP_COST_SAMPLE_STRIDE 16
+#define LOOKUP_HIT_COST 2.0f
 
 namespace MetaPB {
 namespace Operator {
@@ -21,6 +27,7 @@ public:
   }
   virtual void execCPU(const CPU_TCB &cpuTCB) const noexcept override;
   virtual void execDPU(const DPU_TCB &dpuTCB) const noexcept override;
+  virtual float estimatePageCost(const void *page) const noexcept override;
 
   virtual inline constexpr bool checkIfIsTrainable() const noexcept override {
     return true;
@@ -28,6 +35,11 @@ public:
   virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
     return false;
   }
+  // 1: vector compare and popcount per chunk.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept
+      override {
+    return 1;
+  }
 
 private:
   inline static const float target = 2.5f;
@@ -5,6 +5,7 @@ extern "C" {
 #include "Operator/dpu/MAC.h"
 }
 #include "Operator/OperatorBase.hpp"
+#include "Operator/CPUKernels.hpp"
 
 namespace MetaPB {
 namespace Operator {
@@ -29,6 +30,17 @@ public:
   virtual inline constexpr bool checkIfIsCPUOnly() const noexcept override {
     return false;
   }
+  // 1: multi-accumulator vector reduction.
+  virtual inline constexpr uint32_t getCPUKernelRevision() const noexcept
+      override {
+    return 1;
+  }
+  virtual inline bool
+  getDPUChainStage(const DPU_TCB &dpuTCB,
+                   chain_stage &stage) const noexcept override {
+    stage = {CHAIN_OP_MAC, dpuTCB.src2PageIdx, dpuTCB.src2WrapPageCnt, 0};
+    return true;
+  }
 
 private:
   const float weight = 2.5f;
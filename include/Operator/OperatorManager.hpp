@@ -3,8 +3,10 @@
 #include "Executor/TaskGraph.hpp"
 #include "Operator/OperatorAFFINE.hpp"
 #include "Operator/OperatorBase.hpp"
+#include "Operator/OperatorCODEC.hpp"
 #include "Operator/OperatorCONV_1D.hpp"
 #include "Operator/OperatorELEW_ADD.hpp"
+#include "Operator/OperatorELEW_FUSED.hpp"
 #include "Operator/OperatorELEW_PROD.hpp"
 #include "Operator/OperatorEUDIST.hpp"
 #include "Operator/OperatorFILTER.hpp"
@@ -17,88 +19,254 @@
 #include "Operator/OperatorRegistry.hpp"
 #include "Operator/OperatorUNDEFINED.hpp"
 #include "utils/Stats.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
+
+// Accepted modeled DPU slowdown when narrowing to fewer ranks.
+#define RANK_FIT_TIME_SLACK 0.05
 
 namespace MetaPB {
 using perfStats = utils::perfStats;
 using regressionTask = utils::regressionTask;
 namespace Operator {
+using Executor::TaskGraph;
 
 struct OperatorManager {
   void instantiateAll() {
     for (const auto &opTag : allOPSet) {
-      opMap[opTag] = getOperator(opTag);
+      ensureOperator(opTag);
     }
   }
-  void trainModel(const regressionTask &task) {
+  /// @brief elemTypes are the Consensus type tags the graph runs on, typed
+  /// operators get a model per type besides the int one.
+  void trainModel(const regressionTask &task,
+                  const std::set<int> &elemTypes = {}) {
     size_t maxBlk = 0;
     for (const auto &[opTag, dataSizeUpperBound_MiB] : task) {
       size_t blkNum = getNearestPageBlkCnt(dataSizeUpperBound_MiB);
       if (blkNum > maxBlk)
         maxBlk = blkNum;
     }
-    for (auto &[opTag, pageBlkUpperBound] : task) {
-      if (!opMap.contains(opTag)) {
-        opMap[opTag] = std::move(this->getOperator(opTag));
+    // Transfers are priced for every graph, CODEC decides packing.
+    std::vector<OperatorTag> opTags;
+    for (const auto &[opTag, dataSizeUpperBound_MiB] : task) {
+      opTags.push_back(opTag);
+    }
+    for (const auto opTag :
+         {OperatorTag::MAP, OperatorTag::REDUCE, OperatorTag::CODEC}) {
+      if (!task.contains(opTag))
+        opTags.push_back(opTag);
+    }
+    // Element-wise chains may fuse, their fused pass and DPU chain launch
+    // have their own model.
+    for (const auto &[opTag, _] : task) {
+      if (elemwiseOPSet.contains(opTag)) {
+        opTags.push_back(OperatorTag::ELEW_FUSED);
+        break;
       }
-      std::cout << "Training model of " << tag2Name.at(opTag) << std::endl;
-      opMap[opTag]->trainModel(maxBlk);
     }
-    // Always train xfer operator, bloody experience.
-    opMap[OperatorTag::MAP] = std::move(this->getOperator(OperatorTag::MAP));
-    opMap[OperatorTag::REDUCE] =
-        std::move(this->getOperator(OperatorTag::REDUCE));
-    opMap[OperatorTag::MAP]->trainModel(maxBlk);
-    opMap[OperatorTag::REDUCE]->trainModel(maxBlk);
+
+    std::vector<std::pair<OperatorTag, int>> opKeys;
+    for (const auto opTag : opTags) {
+      opKeys.push_back({opTag, INT32_32ALN});
+      if (!typedOPSet.contains(opTag))
+        continue;
+      for (const int elemType : elemTypes) {
+        if (elemType != INT32_32ALN && elemType2Suffix.contains(elemType))
+          opKeys.push_back({opTag, elemType});
+      }
+    }
+
+    // Models already fitted for this bound are kept, the rest try their
+    // caches concurrently, only the misses are probed on hardware.
+    std::vector<OperatorBase *> staleOps;
+    for (const auto &[opTag, elemType] : opKeys) {
+      const auto &op = ensureOperator(opTag, elemType);
+      if (!op->checkIfIsTrained() ||
+          op->getTrainedPageBlkUpperBound() != maxBlk)
+        staleOps.push_back(op.get());
+    }
+    std::vector<std::future<bool>> isLoaded;
+    for (OperatorBase *op : staleOps) {
+      isLoaded.push_back(std::async(std::launch::async, [op, maxBlk] {
+        return op->loadModelCacheIfExist(maxBlk);
+      }));
+    }
+    for (size_t i = 0; i < staleOps.size(); i++) {
+      if (isLoaded[i].get())
+        continue;
+      std::cout << "Training model of " << staleOps[i]->get_name()
+                << staleOps[i]->getElemTypeSuffix() << std::endl;
+      staleOps[i]->trainModel(maxBlk);
+    }
   }
 
   void trainAll(uint32_t pageBlkUpperBound) {
     for (const auto &opSet : allPerfRelOPSet) {
       for (const auto &opTag : opSet) {
-        if (!opMap.contains(opTag)) {
-          opMap[opTag] = std::move(this->getOperator(opTag));
-        }
         std::cout << "Training model of " << tag2Name.at(opTag) << std::endl;
-        opMap[opTag]->trainModel(pageBlkUpperBound);
+        ensureOperator(opTag)->trainModel(pageBlkUpperBound);
       }
     }
   }
 
-  inline void execCPU(OperatorTag opTag, const CPU_TCB &cpuTCB) const noexcept {
-    opMap.at(opTag)->execCPU(cpuTCB);
+  inline void execCPU(OperatorTag opTag, const CPU_TCB &cpuTCB,
+                      const int elemType = INT32_32ALN) const noexcept {
+    ensureOperator(opTag, elemType)->execCPU(cpuTCB);
   }
-  inline void execDPU(OperatorTag opTag, const DPU_TCB &dpuTCB) const noexcept {
-    opMap.at(opTag)->execDPU(dpuTCB);
+  inline void execDPU(OperatorTag opTag, const DPU_TCB &dpuTCB,
+                      const int elemType = INT32_32ALN) const noexcept {
+    ensureOperator(opTag, elemType)->execDPU(dpuTCB);
+  }
+
+  /// @brief This operator as a stage of a fused element-wise chain, false
+  /// when it does not fuse.
+  inline bool getElemwiseStage(OperatorTag opTag, const CPU_TCB &cpuTCB,
+                               ElemwiseStage &stage) const noexcept {
+    return ensureOperator(opTag)->getElemwiseStage(cpuTCB, stage);
+  }
+
+  /// @brief This operator as a stage of a DPU chain launch, false when it
+  /// does not chain.
+  inline bool getDPUChainStage(OperatorTag opTag, const DPU_TCB &dpuTCB,
+                               chain_stage &stage) const noexcept {
+    return ensureOperator(opTag)->getDPUChainStage(dpuTCB, stage);
+  }
+  inline void execDPUChain(const DPU_TCB &dpuTCB,
+                           const std::vector<chain_stage> &stages) const
+      noexcept {
+    static_cast<const OperatorELEW_FUSED &>(
+        *ensureOperator(OperatorTag::ELEW_FUSED))
+        .execDPUChain(dpuTCB, stages);
+  }
+
+  inline float estimatePageCost(OperatorTag opTag,
+                               const void *page) const noexcept {
+    return ensureOperator(opTag)->estimatePageCost(page);
+  }
+  inline std::vector<uint64_t>
+  getDPUFinishCycles(OperatorTag opTag) const noexcept {
+    return ensureOperator(opTag)->getDPUFinishCycles();
+  }
+  inline int64_t getDPUReduction(OperatorTag opTag) const noexcept {
+    return ensureOperator(opTag)->getDPUReduction();
   }
 
   inline perfStats execCPUwithProbe(OperatorTag opTag,
                                     const CPU_TCB &cpuTCB) const noexcept {
-    return {opMap.at(opTag)->execCPUwithProbe(cpuTCB)};
+    return {ensureOperator(opTag)->execCPUwithProbe(cpuTCB)};
   }
 
   inline perfStats execDPUwithProbe(OperatorTag opTag,
                                     const DPU_TCB &dpuTCB) const noexcept {
-    return {opMap.at(opTag)->execDPUwithProbe(dpuTCB)};
+    return {ensureOperator(opTag)->execDPUwithProbe(dpuTCB)};
+  }
+
+  perfStats deducePerfCPU(OperatorTag opTag, const uint32_t pageBlkCnt,
+                          const int elemType = INT32_32ALN) const {
+    return ensureOperator(opTag, elemType)->deducePerfCPU(pageBlkCnt);
+  }
+  perfStats deducePerfDPU(OperatorTag opTag, const uint32_t pageBlkCnt,
+                          const int elemType = INT32_32ALN) const {
+    return ensureOperator(opTag, elemType)->deducePerfDPU(pageBlkCnt);
+  }
+
+  /// @brief Packed MAP/REDUCE cost: host codec + shrunk transfer + DPU codec.
+  /// Only the MAP direction (host pack, DPU unpack) is probed, REDUCE is
+  /// assumed to cost the same with the roles swapped. compressRatio is the
+  /// caller-supplied TaskProperties::xferCompressRatio.
+  perfStats deducePerfPackedXfer(OperatorTag xferTag, const uint32_t pageBlkCnt,
+                                 const double compressRatio) const {
+    const uint32_t packedPageBlkCnt = std::ceil(pageBlkCnt * compressRatio);
+    return deducePerfCPU(OperatorTag::CODEC, pageBlkCnt) +
+           deducePerfDPU(OperatorTag::CODEC, pageBlkCnt) +
+           deducePerfCPU(xferTag, packedPageBlkCnt);
   }
 
-  perfStats deducePerfCPU(OperatorTag opTag, const uint32_t pageBlkCnt) const {
-    return opMap.at(opTag)->deducePerfCPU(pageBlkCnt);
+  /// @brief Fused element-wise chain of stageNum operators on the CPU. The
+  /// pass is memory bound, so the probed chain is scaled by the streams
+  /// touched: src1, the output and one src2 per stage.
+  perfStats deducePerfFusedCPU(const uint32_t stageNum,
+                               const uint32_t pageBlkCnt) const {
+    return deducePerfCPU(OperatorTag::ELEW_FUSED, pageBlkCnt) *
+           (stageNum + 2) / (ELEW_FUSED_MODEL_STAGE_NUM + 2);
   }
-  perfStats deducePerfDPU(OperatorTag opTag, const uint32_t pageBlkCnt) const {
-    return opMap.at(opTag)->deducePerfDPU(pageBlkCnt);
+
+  /// @brief Chain of stageNum operators as one DPU launch, scaled from the
+  /// probed chain the same way: per chunk, src1, the output and one src2 per
+  /// stage go through the MRAM DMA.
+  perfStats deducePerfFusedDPU(const uint32_t stageNum,
+                               const uint32_t pageBlkCnt) const {
+    return deducePerfDPU(OperatorTag::ELEW_FUSED, pageBlkCnt) *
+           (stageNum + 2) / (ELEW_FUSED_MODEL_STAGE_NUM + 2);
+  }
+
+  /// @brief Packing is only enabled when the modeled cost beats raw pages.
+  bool isPackedXferWin(OperatorTag xferTag, const uint32_t pageBlkCnt,
+                       const double compressRatio) const {
+    if (pageBlkCnt == 0 || compressRatio >= 1.0f ||
+        !ensureOperator(OperatorTag::CODEC)->checkIfIsTrained()) {
+      return false;
+    }
+    return deducePerfPackedXfer(xferTag, pageBlkCnt, compressRatio)
+               .timeCost_Second <
+           deducePerfCPU(xferTag, pageBlkCnt).timeCost_Second;
   }
 
-  std::unique_ptr<OperatorBase> getOperator(OperatorTag tag) {
+  /// @brief Operators are built on first use, a graph only pays for the
+  /// operators it actually contains. Types without their own kernels run on
+  /// the int instance. Built operators are read back through opSlots without
+  /// the lock, the MIMIC deduction calls this from every OpenMP thread.
+  const std::unique_ptr<OperatorBase> &
+  ensureOperator(OperatorTag tag,
+                 const int elemType = INT32_32ALN) const noexcept {
+    const size_t slotIdx =
+        (size_t)tag * NR_ELEM_TYPE_SLOT +
+        (elemType >= 0 && elemType < (int)NR_ELEM_TYPE_SLOT ? elemType
+                                                            : INT32_32ALN);
+    if (const auto *op = opSlots[slotIdx].load(std::memory_order_acquire))
+      return *op;
+
+    std::lock_guard<std::mutex> lock(opMapMtx);
+    const std::unique_ptr<OperatorBase> *op;
+    if (elemType != INT32_32ALN && typedOPSet.contains(tag) &&
+        elemType2Suffix.contains(elemType)) {
+      const auto key = std::make_pair(tag, elemType);
+      auto it = typedOpMap.find(key);
+      if (it == typedOpMap.end())
+        it = typedOpMap.emplace(key, getOperator(tag, elemType)).first;
+      op = &it->second;
+    } else {
+      auto it = opMap.find(tag);
+      if (it == opMap.end())
+        it = opMap.emplace(tag, getOperator(tag)).first;
+      op = &it->second;
+    }
+    // Map nodes never move, the slot stays valid for the manager's lifetime.
+    opSlots[slotIdx].store(op, std::memory_order_release);
+    return *op;
+  }
+
+  std::unique_ptr<OperatorBase>
+  getOperator(OperatorTag tag, const int elemType = INT32_32ALN) const {
+    auto &g_DPU_MGR = getDPUMgr();
     switch (tag) {
     case OperatorTag::CONV_1D:
       return std::make_unique<OperatorCONV_1D>(g_DPU_MGR);
     case OperatorTag::ELEW_ADD:
-      return std::make_unique<OperatorELEW_ADD>(g_DPU_MGR);
+      return std::make_unique<OperatorELEW_ADD>(g_DPU_MGR, elemType);
     case OperatorTag::ELEW_PROD:
-      return std::make_unique<OperatorELEW_PROD>(g_DPU_MGR);
+      return std::make_unique<OperatorELEW_PROD>(g_DPU_MGR, elemType);
     case OperatorTag::EUDIST:
       return std::make_unique<OperatorEUDIST>(g_DPU_MGR);
     case OperatorTag::LOGIC_END:
@@ -108,7 +276,7 @@ struct OperatorManager {
     case OperatorTag::LOOKUP:
       return std::make_unique<OperatorLOOKUP>(g_DPU_MGR);
     case OperatorTag::AFFINE:
-      return std::make_unique<OperatorAFFINE>(g_DPU_MGR);
+      return std::make_unique<OperatorAFFINE>(g_DPU_MGR, elemType);
     case OperatorTag::MAP:
       return std::make_unique<OperatorMAP>(g_DPU_MGR);
     case OperatorTag::REDUCE:
@@ -117,28 +285,171 @@ struct OperatorManager {
       return std::make_unique<OperatorFILTER>(g_DPU_MGR);
     case OperatorTag::MAC:
       return std::make_unique<OperatorMAC>(g_DPU_MGR);
+    case OperatorTag::CODEC:
+      return std::make_unique<OperatorCODEC>(g_DPU_MGR);
+    case OperatorTag::ELEW_FUSED:
+      return std::make_unique<OperatorELEW_FUSED>(g_DPU_MGR);
     case OperatorTag::UNDEFINED:
       return std::make_unique<OperatorUNDEFINED>(g_DPU_MGR);
     }
   }
-  OperatorManager(std::uint32_t dpuNum = DPU_ALLOCATE_ALL) : dpuNum(dpuNum) {
-    g_DPU_MGR = std::make_unique<GLOBAL_DPU_MGR>(dpuNum);
-    instantiateAll();
-    pageBlkSize = opMap.at(OperatorTag::MAP)->getPageBlkSize();
+  OperatorManager(std::uint32_t dpuNum = DPU_ALLOCATE_ALL)
+      : dpuNum(dpuNum), bornTime(std::chrono::steady_clock::now()) {
+    // dpu_alloc and binary lookup dominate cold start, run them while the
+    // caller is still building its graph.
+    pendingDPUMgr = std::async(std::launch::async, [dpuNum] {
+      OperatorBase::getDPUBinaryDir();
+      return std::make_unique<GLOBAL_DPU_MGR>(dpuNum);
+    });
+  }
+  /// @brief DPUs launches currently run on, may be fewer than requested
+  /// when ranks are masked out or narrowed by useRanks().
+  inline uint32_t getActiveDPUNum() const noexcept {
+    return getDPUMgr()->getDPUNum();
+  }
+  /// @brief One page per active DPU, known once allocation finished.
+  inline uint32_t getPageBlkSize() const noexcept {
+    getDPUMgr();
+    return pageBlkSize;
+  }
+
+  /// @brief Run the following launches on the first rankNum ranks only.
+  /// Operators stay in place, references handed out remain valid, and are
+  /// rebound to the new geometry; they pick up the models cached for it on
+  /// the next trainModel. Call it between runs, not while one is in flight.
+  void useRanks(const uint32_t rankNum) noexcept {
+    std::lock_guard<std::mutex> lock(opMapMtx);
+    const auto &mgr = getDPUMgr();
+    mgr->useRanks(rankNum);
+    pageBlkSize = mgr->getDPUNum() * PAGE_SIZE_BYTE;
+    for (auto &[_, op] : opMap)
+      op->rebindDPUs(*mgr);
+    for (auto &[_, op] : typedOpMap)
+      op->rebindDPUs(*mgr);
+  }
+
+  /// @brief Fewest ranks whose modeled DPU time stays within
+  /// RANK_FIT_TIME_SLACK of the active set for the largest offloadable task.
+  /// Spreading a share over fewer DPUs is modeled as more pages per DPU on
+  /// the active-set model, call it with every rank active and trained.
+  uint32_t fitRankNum(const TaskGraph &tg) const noexcept {
+    const auto &mgr = getDPUMgr();
+    const uint32_t activeRankNum = mgr->getActiveRankNum();
+    OperatorTag opTag = OperatorTag::UNDEFINED;
+    double maxInputSize_MiB = 0.0f;
+    for (auto [vi, vEnd] = boost::vertices(tg.g); vi != vEnd; ++vi) {
+      const auto &tp = tg.g[*vi];
+      const auto &op = ensureOperator(tp.op);
+      if (!op->checkIfIsTrainable() || op->checkIfIsCPUOnly() ||
+          tp.inputSize_MiB <= maxInputSize_MiB)
+        continue;
+      opTag = tp.op;
+      maxInputSize_MiB = tp.inputSize_MiB;
+    }
+    if (opTag == OperatorTag::UNDEFINED || activeRankNum == 0)
+      return activeRankNum;
+
+    const uint32_t pageBlkCnt = getNearestPageBlkCnt(maxInputSize_MiB);
+    const size_t modeledPageBlkCnt =
+        ensureOperator(opTag)->getTrainedPageBlkUpperBound();
+    const double fullTime_Second =
+        deducePerfDPU(opTag, pageBlkCnt).timeCost_Second;
+    for (uint32_t rankNum = 1; rankNum < activeRankNum; rankNum++) {
+      // Ranks are assumed evenly populated, masked DPUs make this approximate.
+      const uint32_t pageCnt =
+          divceil((uint64_t)pageBlkCnt * activeRankNum, rankNum);
+      if (3 * pageCnt > BCAST_PAGE_IDX || pageCnt > modeledPageBlkCnt)
+        continue;
+      if (deducePerfDPU(opTag, pageCnt).timeCost_Second <=
+          fullTime_Second * (1 + RANK_FIT_TIME_SLACK))
+        return rankNum;
+    }
+    return activeRankNum;
+  }
+
+  /// @brief Right-size the DPU set for a graph and load or probe the models
+  /// of the narrowed geometry. A set narrowed for an earlier graph is widened
+  /// back first, fitRankNum prices from every rank. Returns the rank count
+  /// in use.
+  uint32_t fitRanks(const TaskGraph &tg) noexcept {
+    const auto &mgr = getDPUMgr();
+    const regressionTask task = tg.genRegressionTask();
+    const std::set<int> elemTypes = tg.genElemTypes();
+    if (mgr->getActiveRankNum() != mgr->getRankNum()) {
+      useRanks(mgr->getRankNum());
+      trainModel(task, elemTypes);
+    }
+    const uint32_t rankNum = fitRankNum(tg);
+    if (rankNum != mgr->getActiveRankNum()) {
+      useRanks(rankNum);
+      trainModel(task, elemTypes);
+    }
+    return rankNum;
+  }
+  inline uint32_t getNearestPageBlkCnt(double inputSize_MiB) const noexcept {
+    return std::ceil(inputSize_MiB * (1 << 20) / getPageBlkSize());
+  }
+
+  /// @brief Output of opTag on inputSize_MiB with the active DPUs.
+  inline double getOutputSize_MiB(OperatorTag opTag,
+                                  const double inputSize_MiB) const noexcept {
+    return outputSize_MiB(opTag, inputSize_MiB,
+                          getPageBlkSize() / PAGE_SIZE_BYTE);
+  }
+
+  /// @brief Pages every DPU holds of a broadcast operand, 0 if it does not
+  /// fit the broadcast region.
+  inline uint32_t getBcastPageCnt(double payload_MiB) const noexcept {
+    const uint32_t pageCnt = std::ceil(payload_MiB * (1 << 20) / PAGE_SIZE_BYTE);
+    return pageCnt <= NR_BCAST_PAGE ? pageCnt : 0;
   }
-  inline uint32_t getPageBlkSize() const noexcept { return pageBlkSize; }
-  std::map<OperatorTag, std::unique_ptr<OperatorBase>> opMap;
-  /*
-  inline static std::unique_ptr<GLOBAL_DPU_MGR> g_DPU_MGR =
-      std::make_unique<GLOBAL_DPU_MGR>();
-      */
-  inline uint32_t getNearestPageBlkCnt(size_t inputSize_MiB) const noexcept{
-    return ((size_t)inputSize_MiB * (size_t)(1<<20) + pageBlkSize - 1) / pageBlkSize;
+
+  /// @brief Blocks until the background allocation is done.
+  std::unique_ptr<GLOBAL_DPU_MGR> &getDPUMgr() const noexcept {
+    std::call_once(dpuMgrOnce, [this] {
+      g_DPU_MGR = pendingDPUMgr.get();
+      pageBlkSize = g_DPU_MGR->getDPUNum() * PAGE_SIZE_BYTE;
+    });
+    return g_DPU_MGR;
   }
-  std::unique_ptr<GLOBAL_DPU_MGR> g_DPU_MGR;
+
+  /// @brief Schedulers report here once a schedule is ready, the first report
+  /// fixes the time-to-first-schedule measured from construction.
+  void markScheduled() const noexcept {
+    if (timeToFirstSchedule_Second >= 0.0f)
+      return;
+    timeToFirstSchedule_Second =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                      bornTime)
+            .count();
+    std::cout << "Time to first schedule: " << timeToFirstSchedule_Second
+              << " s" << std::endl;
+  }
+  inline double getTimeToFirstSchedule_Second() const noexcept {
+    return timeToFirstSchedule_Second;
+  }
+
+  mutable std::map<OperatorTag, std::unique_ptr<OperatorBase>> opMap;
+  // Non-int instances of typedOPSet, by operator and Consensus type tag.
+  mutable std::map<std::pair<OperatorTag, int>, std::unique_ptr<OperatorBase>>
+      typedOpMap;
+  mutable std::unique_ptr<GLOBAL_DPU_MGR> g_DPU_MGR;
 
   const std::uint32_t dpuNum;
-  uint32_t pageBlkSize;
+
+private:
+  // Set with g_DPU_MGR under dpuMgrOnce and by useRanks() only.
+  mutable uint32_t pageBlkSize = 0;
+  mutable std::future<std::unique_ptr<GLOBAL_DPU_MGR>> pendingDPUMgr;
+  mutable std::once_flag dpuMgrOnce;
+  mutable std::mutex opMapMtx;
+  // One slot per operator and Consensus type tag, null until built.
+  static constexpr size_t NR_ELEM_TYPE_SLOT = FLOAT32_32ALN + 1;
+  mutable std::array<std::atomic<const std::unique_ptr<OperatorBase> *>,
+                     ((size_t)OperatorTag::UNDEFINED + 1) * NR_ELEM_TYPE_SLOT>
+      opSlots{};
+  const std::chrono::steady_clock::time_point bornTime;
+  mutable double timeToFirstSchedule_Second = -1.0f;
 };
 
 } // namespace Operator
@@ -2,6 +2,7 @@
 #define OP_REDUCE_HPP
 
 #include "Operator/OperatorBase.hpp"
+#include "Operator/XferCodec.hpp"
 
 namespace MetaPB {
 namespace Operator {
@@ -9,7 +10,7 @@ namespace Operator {
 class OperatorREDUCE : public OperatorBase {
 public:
   OperatorREDUCE(std::unique_ptr<GLOBAL_DPU_MGR> &g_DPU_MGR)
-      : OperatorBase(g_DPU_MGR) {}
+      : OperatorBase(g_DPU_MGR), codec(allDPUs, dpuNum) {}
   inline virtual const std::string get_name() const noexcept override {
     return OpName;
   }
@@ -26,7 +27,13 @@ public:
     return true;
   }
 
+  virtual void rebindDPUs(const GLOBAL_DPU_MGR &g_DPU_MGR) noexcept override {
+    OperatorBase::rebindDPUs(g_DPU_MGR);
+    codec.rebind(dpuNum);
+  }
+
 private:
+  mutable XferCodec codec;
   inline static const std::string OpName = "REDUCE";
 };
 } // namespace Operator
@@ -1,8 +1,12 @@
 #ifndef OP_REGISTRY
 #define OP_REGISTRY
+#include "utils/Consensus.h"
+#include <algorithm>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 using std::map;
 using std::set;
@@ -22,6 +26,8 @@ enum class OperatorTag {
   REDUCE,      // Transfer Operator that gather data from DPU
   MAC,         // Vector Multiply-Accumulate operator
   FILTER,      // Windowed Average Operator
+  CODEC,       // Transfer codec that packs MAP/REDUCE payload
+  ELEW_FUSED,  // Fused chain of element-wise operators
   UNDEFINED    // Undefined Operator
 };
 
@@ -38,6 +44,8 @@ static const map<OperatorTag, std::string> tag2Name = {
     {OperatorTag::REDUCE, "REDUCE"},
     {OperatorTag::MAC, "MAC"},
     {OperatorTag::FILTER, "FILTER"},
+    {OperatorTag::CODEC, "CODEC"},
+    {OperatorTag::ELEW_FUSED, "ELEW_FUSED"},
     {OperatorTag::UNDEFINED, "UNDEFINED"},
 };
 
@@ -50,21 +58,105 @@ static const set<OperatorTag> memoryBoundOPSet = {
     OperatorTag::LOOKUP, OperatorTag::ELEW_PROD, OperatorTag::ELEW_ADD,
 };
 
-static const set<OperatorTag> xferOPSet = {OperatorTag::MAP,
-                                           OperatorTag::REDUCE};
+/// @brief Operators that fold every DPU_DMA_BFFR_BYTE chunk into one int.
+static const set<OperatorTag> reductionOPSet = {
+    OperatorTag::EUDIST, OperatorTag::MAC, OperatorTag::LOOKUP};
+
+/// @brief Output size of an operator run on inputSize_MiB over dpuNum DPUs.
+/// A reduction leaves one int64 partial per DPU, whatever its element type,
+/// input size or DMA block.
+static inline double outputSize_MiB(OperatorTag opTag,
+                                    const double inputSize_MiB,
+                                    const uint32_t dpuNum) {
+  if (!reductionOPSet.contains(opTag))
+    return inputSize_MiB;
+  return std::min(inputSize_MiB,
+                  (double)dpuNum * sizeof(int64_t) / (1 << 20));
+}
+
+/// @brief Operators whose src2 may be a broadcast operand.
+static const set<OperatorTag> bcastOperandOPSet = {
+    OperatorTag::AFFINE, OperatorTag::MAC, OperatorTag::EUDIST,
+    OperatorTag::ELEW_PROD, OperatorTag::ELEW_ADD};
+
+/// @brief Operators whose DPU time depends on the data, their pages are
+/// balanced across DPUs by estimated cost and their launches report
+/// per-DPU finish cycles.
+static const set<OperatorTag> skewAwareOPSet = {OperatorTag::LOOKUP};
+
+static const set<OperatorTag> xferOPSet = {
+    OperatorTag::MAP, OperatorTag::REDUCE, OperatorTag::CODEC};
+
+/// @brief Operators that fuse into one pass over memory on the CPU when
+/// chained, priced by the ELEW_FUSED model.
+static const set<OperatorTag> elemwiseOPSet = {
+    OperatorTag::AFFINE, OperatorTag::ELEW_ADD, OperatorTag::ELEW_PROD};
+static const set<OperatorTag> fusedOPSet = {OperatorTag::ELEW_FUSED};
+/// @brief Operators that run as stages of one ELEW_FUSED launch when chained
+/// on the DPU, a reduction only as the last stage.
+static const set<OperatorTag> dpuChainOPSet = {
+    OperatorTag::AFFINE, OperatorTag::ELEW_ADD, OperatorTag::ELEW_PROD,
+    OperatorTag::MAC, OperatorTag::EUDIST};
+
+/// @brief Element types with their own kernels and models, by Consensus type
+/// tag. int is the default and keeps the untyped binary and model names.
+static const map<int, std::string> elemType2Suffix = {
+    {CHAR8_32ALN, "_I8"},
+    {SHORT16_32ALN, "_I16"},
+    {INT32_32ALN, ""},
+    {FLOAT32_32ALN, "_F32"}};
+/// @brief Operators built for every type of elemType2Suffix, the rest only
+/// take int.
+static const set<OperatorTag> typedOPSet = {
+    OperatorTag::AFFINE, OperatorTag::ELEW_ADD, OperatorTag::ELEW_PROD};
+
+/// @brief Operators whose int DPU kernel is autotuned over the variants
+/// add_dpu_variants builds in src/Operator/dpu/CMakeLists.txt.
+static const set<OperatorTag> dpuTunedOPSet = {
+    OperatorTag::AFFINE,   OperatorTag::EUDIST,    OperatorTag::CONV_1D,
+    OperatorTag::LOOKUP,   OperatorTag::ELEW_PROD, OperatorTag::ELEW_ADD,
+    OperatorTag::MAC,      OperatorTag::FILTER,    OperatorTag::ELEW_FUSED};
+/// @brief Tuned kernels that pad at DMA block edges, only their tasklets and
+/// unroll vary.
+static const set<OperatorTag> dpuWindowedOPSet = {OperatorTag::FILTER,
+                                                  OperatorTag::CONV_1D};
+#define DPU_VARIANT_WRAM_BUDGET_BYTE (12 * 3 * 1024)
+
+/// @brief Binary suffixes of the DPU variants of opTag, the unsuffixed
+/// default first. Mirrors add_dpu_variants.
+static inline std::vector<std::string> getDPUVariants(OperatorTag opTag) {
+  std::vector<std::string> variants = {""};
+  if (!dpuTunedOPSet.contains(opTag))
+    return variants;
+  const std::vector<uint32_t> blocks =
+      dpuWindowedOPSet.contains(opTag) ? std::vector<uint32_t>{1024}
+                                       : std::vector<uint32_t>{512, 1024, 2048};
+  for (const uint32_t tasklets : {8, 12, 16})
+    for (const uint32_t block : blocks) {
+      if (tasklets * 3 * block > DPU_VARIANT_WRAM_BUDGET_BYTE)
+        continue;
+      for (const uint32_t unroll : {1, 4})
+        if (tasklets != 12 || block != 1024 || unroll != 1)
+          variants.push_back("_T" + std::to_string(tasklets) + "_B" +
+                             std::to_string(block) + "_U" +
+                             std::to_string(unroll));
+    }
+  return variants;
+}
 
 static const set<set<OperatorTag>> hybridOPSet = {computeBoundOPSet,
                                                   memoryBoundOPSet};
 
 /// @brief Set of all performance related Operator set.
 static const set<set<OperatorTag>> allPerfRelOPSet = {
-    computeBoundOPSet, memoryBoundOPSet, xferOPSet};
+    computeBoundOPSet, memoryBoundOPSet, xferOPSet, fusedOPSet};
 
 static const set<OperatorTag> allOPSet = {
     OperatorTag::AFFINE,      OperatorTag::EUDIST,    OperatorTag::CONV_1D,
     OperatorTag::LOOKUP,      OperatorTag::ELEW_PROD, OperatorTag::ELEW_ADD,
     OperatorTag::LOGIC_START, OperatorTag::LOGIC_END, OperatorTag::MAP,
     OperatorTag::REDUCE,      OperatorTag::MAC,       OperatorTag::FILTER,
+    OperatorTag::CODEC,       OperatorTag::ELEW_FUSED,
     OperatorTag::UNDEFINED};
 
 enum class OperatorType {
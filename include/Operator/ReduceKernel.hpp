@@ -0,0 +1,129 @@
+#ifndef REDUCE_KERNEL_HPP
+#define REDUCE_KERNEL_HPP
+
+#include "Operator/KernelISA.hpp"
+#include <cstdint>
+
+namespace MetaPB {
+namespace Operator {
+
+enum class ReduceKind { MAC, EUDIST };
+
+inline namespace METAPB_KERNEL_ISA {
+
+template <ReduceKind kind>
+inline int reduceItem(const int a, const int b) noexcept {
+  if constexpr (kind == ReduceKind::MAC) {
+    return a * b;
+  } else {
+    // ignoring sqrt because DPU doesn't have hardware sqrt
+    return (b - a) * (b - a);
+  }
+}
+
+#ifdef METAPB_KERNEL_AVX512
+template <ReduceKind kind>
+inline __m512i reduceLane(const int *a, const int *b) noexcept {
+  const __m512i va = _mm512_loadu_si512(a);
+  const __m512i vb = _mm512_loadu_si512(b);
+  if constexpr (kind == ReduceKind::MAC) {
+    return _mm512_mullo_epi32(va, vb);
+  } else {
+    const __m512i diff = _mm512_sub_epi32(vb, va);
+    return _mm512_mullo_epi32(diff, diff);
+  }
+}
+#endif
+
+/// @brief Sum of reduceItem over one chunk. Four independent accumulators
+/// keep the adds off a single dependency chain, the partial is returned
+/// once for the caller to store.
+template <ReduceKind kind>
+inline int reduceChunk(const int *a, const int *b,
+                       const uint32_t itemNum) noexcept {
+  uint32_t i = 0;
+  int sum = 0;
+#ifdef METAPB_KERNEL_AVX512
+  __m512i acc0 = _mm512_setzero_si512(), acc1 = acc0, acc2 = acc0,
+          acc3 = acc0;
+  for (; i + 64 <= itemNum; i += 64) {
+    acc0 = _mm512_add_epi32(acc0, reduceLane<kind>(a + i, b + i));
+    acc1 = _mm512_add_epi32(acc1, reduceLane<kind>(a + i + 16, b + i + 16));
+    acc2 = _mm512_add_epi32(acc2, reduceLane<kind>(a + i + 32, b + i + 32));
+    acc3 = _mm512_add_epi32(acc3, reduceLane<kind>(a + i + 48, b + i + 48));
+  }
+  for (; i + 16 <= itemNum; i += 16) {
+    acc0 = _mm512_add_epi32(acc0, reduceLane<kind>(a + i, b + i));
+  }
+  sum = _mm512_reduce_add_epi32(_mm512_add_epi32(_mm512_add_epi32(acc0, acc1),
+                                                 _mm512_add_epi32(acc2, acc3)));
+#else
+  int acc[4] = {0, 0, 0, 0};
+  for (; i + 4 <= itemNum; i += 4) {
+    for (int l = 0; l < 4; l++) {
+      acc[l] += reduceItem<kind>(a[i + l], b[i + l]);
+    }
+  }
+  sum = acc[0] + acc[1] + acc[2] + acc[3];
+#endif
+  for (; i < itemNum; i++) {
+    sum += reduceItem<kind>(a[i], b[i]);
+  }
+  return sum;
+}
+
+/// @brief Number of items equal to target in one chunk, a compare mask and
+/// a popcount per 16 items.
+inline int countChunk(const int *src, const int target,
+                      const uint32_t itemNum) noexcept {
+  uint32_t i = 0;
+  int hitNum = 0;
+#ifdef METAPB_KERNEL_AVX512
+  const __m512i vTarget = _mm512_set1_epi32(target);
+  int hit0 = 0, hit1 = 0;
+  for (; i + 32 <= itemNum; i += 32) {
+    hit0 += __builtin_popcount(
+        _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(src + i), vTarget));
+    hit1 += __builtin_popcount(
+        _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(src + i + 16), vTarget));
+  }
+  hitNum = hit0 + hit1;
+#endif
+  for (; i < itemNum; i++) {
+    hitNum += src[i] == target;
+  }
+  return hitNum;
+}
+
+/// @brief Sum of the int64 partials a reduction leaves per DPU, the host's
+/// final combine.
+inline int64_t combinePartials(const int64_t *partials,
+                               const uint32_t partialNum) noexcept {
+  uint32_t i = 0;
+  int64_t sum = 0;
+#ifdef METAPB_KERNEL_AVX512
+  __m512i acc0 = _mm512_setzero_si512(), acc1 = acc0;
+  for (; i + 16 <= partialNum; i += 16) {
+    acc0 = _mm512_add_epi64(acc0, _mm512_loadu_si512(partials + i));
+    acc1 = _mm512_add_epi64(acc1, _mm512_loadu_si512(partials + i + 8));
+  }
+  sum = _mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1));
+#else
+  int64_t acc[4] = {0, 0, 0, 0};
+  for (; i + 4 <= partialNum; i += 4) {
+    for (int l = 0; l < 4; l++) {
+      acc[l] += partials[i + l];
+    }
+  }
+  sum = acc[0] + acc[1] + acc[2] + acc[3];
+#endif
+  for (; i < partialNum; i++) {
+    sum += partials[i];
+  }
+  return sum;
+}
+
+} // namespace METAPB_KERNEL_ISA
+} // namespace Operator
+} // namespace MetaPB
+#endif
@@ -0,0 +1,76 @@
+#ifndef XFER_CODEC_HPP
+#define XFER_CODEC_HPP
+
+extern "C" {
+#include "Operator/dpu/CODEC.h"
+}
+#include "DPU_GLOBAL.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MetaPB {
+namespace Operator {
+
+/// @brief Host side of packed MAP/REDUCE. Page blocks are moved in rounds of
+/// CODEC_ROUND_PAGE, each (page, DPU) pair is packed into its own host slot
+/// and shipped as one scatter-gather block, so a round is one transfer plus
+/// one CODEC kernel launch.
+class XferCodec {
+public:
+  XferCodec(dpu_set_t &dpuSet, const uint32_t dpuNum)
+      : allDPUs(dpuSet), dpuNum(dpuNum) {}
+  /// @brief The set was narrowed in place, slots already reserved stay valid.
+  inline void rebind(const uint32_t dpuNum) noexcept { this->dpuNum = dpuNum; }
+
+  /// @brief Pack host page blocks and unpack them into DPU pages.
+  void scatter(const std::string &unpackBinary, void *cpuPageBlkBaseAddr,
+               const uint32_t dpuPageBaseIdx,
+               const uint32_t pageBlkCnt) noexcept;
+
+  /// @brief Pack DPU pages in place and unpack them into host page blocks.
+  void gather(const std::string &packBinary, void *cpuPageBlkBaseAddr,
+              const uint32_t dpuPageBaseIdx,
+              const uint32_t pageBlkCnt) noexcept;
+
+  /// @brief Host-only packing of a round, also used to probe encode cost.
+  void packRound(const void *cpuPageBlkBaseAddr, const uint32_t roundBase,
+                 const uint32_t pageCnt) noexcept;
+
+  /// @brief Host-only unpacking of a round into host page blocks.
+  void unpackRound(void *cpuPageBlkBaseAddr, const uint32_t roundBase,
+                   const uint32_t pageCnt) noexcept;
+
+private:
+  typedef struct codec_sg_context {
+    XferCodec *codec;
+    uint32_t pageCnt = 0;
+  } codec_sg_context;
+
+  inline codec_header &header(uint32_t page, uint32_t dpu) noexcept {
+    return headers[(size_t)dpu * CODEC_ROUND_PAGE + page];
+  }
+  inline uint32_t *slot(uint32_t page, uint32_t dpu) noexcept {
+    return slots.data() +
+           ((size_t)page * dpuNum + dpu) * CODEC_ITEM_PER_PAGE;
+  }
+  void reserve(const uint32_t pageCnt) noexcept;
+  void layoutRound(const uint32_t pageCnt) noexcept;
+  size_t maxPayloadByte(const uint32_t pageCnt) const noexcept;
+
+  static bool get_packed_block(struct sg_block_info *out, uint32_t dpu_index,
+                               uint32_t block_index, void *args);
+  static bool get_header_block(struct sg_block_info *out, uint32_t dpu_index,
+                               uint32_t block_index, void *args);
+  static bool get_payload_block(struct sg_block_info *out, uint32_t dpu_index,
+                                uint32_t block_index, void *args);
+
+  dpu_set_t &allDPUs;
+  uint32_t dpuNum;
+  std::vector<codec_header> headers; // [dpu][page] of current round
+  std::vector<uint32_t> slots;       // [page][dpu] packed page slots
+};
+
+} // namespace Operator
+} // namespace MetaPB
+#endif
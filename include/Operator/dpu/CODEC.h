@@ -0,0 +1,95 @@
+#ifndef CODEC_H
+#define CODEC_H
+
+#include "Operator/dpu/common.h"
+#include <stdint.h>
+
+// Frame-of-reference page codec shared by host and DPU.
+// Every 4KiB page is stored as (value - base) packed with a fixed bit width,
+// a bit width of 32 keeps the page raw so incompressible data never grows.
+// Packed bytes of a DMA chunk are always a multiple of 8, so any chunk of a
+// packed page can be fetched by mram_read independently.
+
+#define CODEC_ITEM_PER_PAGE (PAGE_SIZE_BYTE / 4)
+#define CODEC_ITEM_PER_CHUNK (DPU_DMA_BFFR_BYTE / 4)
+#define CODEC_CHUNK_PER_PAGE (PAGE_SIZE_BYTE / DPU_DMA_BFFR_BYTE)
+
+// Packed transfers are split into rounds, each round owns a MRAM stage at
+// the tail of the page buffer: [header table][packed payload].
+// A round moves CODEC_ROUND_PAGE page blocks, its header table must fit in
+// CODEC_HEADER_PAGE pages.
+#define CODEC_ROUND_PAGE 64
+#define CODEC_HEADER_BYTE 16
+#define CODEC_HEADER_PAGE 1
+#define CODEC_STAGE_PAGE (CODEC_HEADER_PAGE + CODEC_ROUND_PAGE)
+#define CODEC_STAGE_PAGE_IDX (NR_SINGLE_DPU_PAGE - CODEC_STAGE_PAGE)
+
+// Read-only operands shared by every DPU are broadcast once into a region
+// right below the stage, regular page blocks end at BCAST_PAGE_IDX.
+#define NR_BCAST_PAGE 256
+#define BCAST_PAGE_IDX (CODEC_STAGE_PAGE_IDX - NR_BCAST_PAGE)
+
+// Launch statistics a kernel leaves for the host to read right after the
+// launch. The stage is only busy during packed transfers, never then.
+#define DPU_STAT_PAGE_IDX CODEC_STAGE_PAGE_IDX
+
+typedef struct codec_header {
+  int32_t base;
+  uint32_t bitWidth;
+  uint32_t offset; // payload byte offset of this page inside its round
+  uint32_t reserved;
+} codec_header;
+
+typedef struct {
+  DPU_TCB_c dpuTCB; // src1: packed stage / raw pages, dst: raw pages / stage
+} codec_args;
+
+static inline uint32_t codec_page_byte(uint32_t bitWidth) {
+  return bitWidth * (CODEC_ITEM_PER_PAGE / 8);
+}
+
+static inline uint32_t codec_chunk_byte(uint32_t bitWidth) {
+  return bitWidth * (CODEC_ITEM_PER_CHUNK / 8);
+}
+
+// Bit width that covers [0, range], at least 1 to keep every SG block
+// non-empty.
+static inline uint32_t codec_bit_width(uint32_t range) {
+  uint32_t bitWidth = 1;
+  while (bitWidth < 32 && (range >> bitWidth))
+    bitWidth++;
+  return bitWidth;
+}
+
+static inline void codec_pack(const int32_t *src, uint32_t *dst, int32_t base,
+                              uint32_t bitWidth, uint32_t itemNum) {
+  uint32_t wordNum = (itemNum * bitWidth) >> 5;
+  for (uint32_t w = 0; w < wordNum; w++)
+    dst[w] = 0;
+  uint32_t bitPos = 0;
+  for (uint32_t i = 0; i < itemNum; i++, bitPos += bitWidth) {
+    uint32_t v = (uint32_t)src[i] - (uint32_t)base;
+    uint32_t word = bitPos >> 5;
+    uint32_t shift = bitPos & 31;
+    dst[word] |= v << shift;
+    if (shift + bitWidth > 32)
+      dst[word + 1] |= v >> (32 - shift);
+  }
+}
+
+static inline void codec_unpack(const uint32_t *src, int32_t *dst,
+                                int32_t base, uint32_t bitWidth,
+                                uint32_t itemNum) {
+  uint32_t mask = bitWidth == 32 ? 0xFFFFFFFFu : ((1u << bitWidth) - 1);
+  uint32_t bitPos = 0;
+  for (uint32_t i = 0; i < itemNum; i++, bitPos += bitWidth) {
+    uint32_t word = bitPos >> 5;
+    uint32_t shift = bitPos & 31;
+    uint32_t v = src[word] >> shift;
+    if (shift + bitWidth > 32)
+      v |= src[word + 1] << (32 - shift);
+    dst[i] = (int32_t)((v & mask) + (uint32_t)base);
+  }
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef ELEW_FUSED_H
+#define ELEW_FUSED_H
+
+#include "Operator/dpu/common.h"
+
+// Operators a chain stage runs, a reduction only as the last stage. Op
+// codes from CHAIN_OP_MAC on are reductions.
+#define CHAIN_OP_ADD 0
+#define CHAIN_OP_PROD 1
+#define CHAIN_OP_AFFINE 2
+#define CHAIN_OP_MAC 3
+#define CHAIN_OP_EUDIST 4
+
+#define CHAIN_MAX_STAGE_NUM 8
+
+// One operator of the chain, applied to the running chunk with its own src2.
+typedef struct chain_stage {
+  unsigned int opCode;
+  unsigned int src2PageIdx;
+  unsigned int src2WrapPageCnt; // broadcast src2 length, 0 if not
+  int weight; // AFFINE, converted to the int elements like AFFINE does
+} chain_stage;
+
+typedef struct {
+  unsigned int src1PageIdx; // input of the first stage
+  unsigned int dstPageIdx;  // output of the last stage
+  unsigned int pageCnt;
+  unsigned int stageNum;
+  chain_stage stages[CHAIN_MAX_STAGE_NUM];
+} chain_args;
+
+#endif
@@ -1,4 +1,8 @@
 #include "Operator/dpu/common.h"
+
+// Window width, fixed so both sides divide by a constant.
+#define FILTER_KERNEL_SIZE 8
+
 typedef struct {
   DPU_TCB_c dpuTCB;
   float gaussianKernel[8];
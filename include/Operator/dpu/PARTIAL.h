@@ -0,0 +1,35 @@
+#ifndef PARTIAL_H
+#define PARTIAL_H
+
+#include "Operator/dpu/CODEC.h"
+#include <stdint.h>
+
+// Reduction kernels fold their whole share into one int64 partial per DPU,
+// left in the stat page right after the finish cycle. The host gathers the
+// partials of all DPUs and combines them, no output page comes back.
+#define DPU_STAT_PARTIAL_OFFSET_BYTE 8
+
+#ifndef __cplusplus
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+
+// Tree combine of one partial per tasklet in WRAM, log2(NR_TASKLETS) rounds
+// behind the barrier. Every tasklet has to call it, tasklet 0 ends up with
+// the DPU partial and writes it out.
+static inline void partial_combine(int64_t *partials, barrier_t *barrier,
+                                   __mram_ptr void *statPage) {
+  unsigned int tasklet_id = me();
+  barrier_wait(barrier);
+  for (unsigned int stride = 1; stride < NR_TASKLETS; stride <<= 1) {
+    if (tasklet_id % (2 * stride) == 0 && tasklet_id + stride < NR_TASKLETS)
+      partials[tasklet_id] += partials[tasklet_id + stride];
+    barrier_wait(barrier);
+  }
+  if (tasklet_id == 0)
+    mram_write(partials, statPage + DPU_STAT_PARTIAL_OFFSET_BYTE,
+               sizeof(int64_t));
+}
+#endif
+
+#endif
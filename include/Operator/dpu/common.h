@@ -6,10 +6,20 @@
 #endif
 
 #define PAGE_SIZE_BYTE 4096
+// DMA block and hot loop unroll factor, set per autotuned variant.
+#ifndef DPU_DMA_BFFR_BYTE
 #define DPU_DMA_BFFR_BYTE 1024
+#endif
+#ifndef DPU_UNROLL
+#define DPU_UNROLL 1
+#endif
+#define DPU_PRAGMA(x) _Pragma(#x)
+#define DPU_UNROLL_BY(n) DPU_PRAGMA(unroll n)
+#define DPU_UNROLL_LOOP DPU_UNROLL_BY(DPU_UNROLL)
 #define NR_SINGLE_DPU_PAGE 15360
 
-#ifndef __cplusplus
+// Element type, typed kernels are built once more per type with -DT=<type>.
+#if !defined(__cplusplus) && !defined(T)
 #define T int
 #endif
 
@@ -21,6 +31,7 @@ typedef struct DPU_TCB_c {
   unsigned int src2PageIdx;
   unsigned int dstPageIdx;
   unsigned int pageCnt;
+  unsigned int src2WrapPageCnt; // broadcast src2 length, 0 if as long as src1
 } DPU_TCB_c;
 
 #endif
@@ -1,5 +1,6 @@
 #ifndef METASCHED_HPP
 #define METASCHED_HPP
+#include "Distributed/ClusterModel.hpp"
 #include "Executor/HeteroComputePool.hpp"
 #include "Executor/TaskGraph.hpp"
 #include "Optimizer/OptimizerAOA.hpp"
@@ -44,6 +45,16 @@ public:
     Schedule result;
     HEFTorder = heSchedule.order;
   }
+  /// @brief Schedule one node of a data-parallel cluster: proposals are
+  /// evaluated on a node's share plus the inter-node boundary traffic.
+  void setCluster(const uint32_t nodeNum,
+                  const Distributed::NetworkModel &net) noexcept {
+    this->nodeNum = nodeNum;
+    // Last node owns the largest share, it bounds the makespan.
+    partTg = Distributed::partitionGraph(tg, nodeNum - 1, nodeNum);
+    netCost = net.deduceXfer(
+        Distributed::boundaryXfer_MiB(tg, om.getActiveDPUNum()), 2 * nodeNum);
+  }
   Schedule schedule() noexcept;
   std::vector<float> evalSchedules(const vector<vector<float>> &ratioVecs);
   OptimizerInfos getOptInfo() const noexcept { return optInfo; }
@@ -58,6 +69,12 @@ private:
                     // execute on this
   const size_t OptIterMax;
 
+  // --------- cluster mode ----------
+  uint32_t nodeNum = 1;
+  TaskGraph partTg;
+  perfStats netCost;
+  // --------- cluster mode ----------
+
   // --------- showoff use ----------
   OptimizerInfos optInfo;
   // --------- showoff use ----------
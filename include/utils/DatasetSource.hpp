@@ -0,0 +1,48 @@
+#ifndef DATASET_SRC_HPP
+#define DATASET_SRC_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace MetaPB {
+namespace utils {
+
+/// @brief Read-only, zero-copy view of a binary input file.
+// The file is mapped instead of copied into the memory pool, so CPU kernels
+// and scatter-gather MAP read it in place. The file is expected to already be
+// laid out as page blocks (page-major, DPU-minor), same as the pool.
+// The mapping is padded to whole page blocks with zero pages, so the tail
+// block never reads past the end of the file.
+class DatasetSource {
+public:
+  DatasetSource(const std::string &path, const size_t pageBlkSize) noexcept;
+  DatasetSource(DatasetSource &&other) noexcept;
+  DatasetSource(const DatasetSource &) = delete;
+  DatasetSource &operator=(const DatasetSource &) = delete;
+  ~DatasetSource() noexcept;
+
+  inline bool isValid() const noexcept { return base != nullptr; }
+  inline const char *data() const noexcept { return base; }
+  inline size_t getFileSize_Byte() const noexcept { return fileSize_Byte; }
+  inline double getFileSize_MiB() const noexcept {
+    return (double)fileSize_Byte / (1 << 20);
+  }
+  inline size_t getPageBlkCnt() const noexcept {
+    return mappedSize_Byte / pageBlkSize;
+  }
+  /// @brief Host address of the idx-th page block inside the mapping.
+  inline const char *getPageBlk(const size_t idx) const noexcept {
+    return base + idx * pageBlkSize;
+  }
+
+private:
+  std::string path;
+  size_t pageBlkSize = 0;
+  size_t fileSize_Byte = 0;
+  size_t mappedSize_Byte = 0;
+  char *base = nullptr;
+};
+
+} // namespace utils
+} // namespace MetaPB
+#endif
@@ -0,0 +1,91 @@
+#ifndef OUTPUT_CACHE_HPP
+#define OUTPUT_CACHE_HPP
+
+#include "utils/Stats.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace MetaPB {
+namespace utils {
+
+/// @brief Host-memory cache of node outputs, keyed by content.
+// Keys chain the operator, the page geometry and the keys of the producers,
+// so only graph inputs are ever hashed. Entries are filled piece by piece as
+// the shares of a node land on the host, become visible once complete and
+// are evicted least recently used beyond the byte budget. Entries pinned by
+// a running workload are never evicted.
+class OutputCache {
+public:
+  explicit OutputCache(const size_t budget_Byte) noexcept
+      : budget_Byte(budget_Byte) {}
+  OutputCache(const OutputCache &) = delete;
+  OutputCache &operator=(const OutputCache &) = delete;
+
+  /// @brief Caller-supplied version of the graph inputs, 0 hashes them.
+  inline void setSourceVersion(const uint64_t version) noexcept {
+    sourceVersion = version;
+  }
+  inline uint64_t getSourceVersion() const noexcept { return sourceVersion; }
+
+  static uint64_t hashBytes(const void *addr, const size_t size_Byte) noexcept;
+  static inline uint64_t combine(const uint64_t seed,
+                                 const uint64_t value) noexcept {
+    return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+  }
+
+  /// @brief True if the entry is complete, it then stays until unpinAll().
+  bool pin(const uint64_t key) noexcept;
+  /// @brief End of a run, also drops the entries left incomplete.
+  void unpinAll() noexcept;
+
+  /// @brief Copy a complete entry of exactly size_Byte out to dst.
+  bool restore(const uint64_t key, void *dst,
+               const size_t size_Byte) noexcept;
+
+  /// @brief Copy one piece of a size_Byte output into its entry.
+  void fill(const uint64_t key, const size_t size_Byte,
+            const size_t offset_Byte, const void *src,
+            const size_t pieceSize_Byte) noexcept;
+
+  void recordHit(const perfStats &saved) noexcept;
+  void recordMiss() noexcept;
+  void printReport() const noexcept;
+
+  inline size_t getHitNum() const noexcept { return hitNum; }
+  inline size_t getMissNum() const noexcept { return missNum; }
+  inline perfStats getSaved() const noexcept { return saved; }
+  inline size_t getCachedSize_Byte() const noexcept { return cached_Byte; }
+
+private:
+  typedef struct entry {
+    std::vector<char> bytes;
+    size_t filled_Byte = 0;
+    bool isPinned = false;
+    std::list<uint64_t>::iterator lruPos;
+  } entry;
+
+  inline bool isComplete(const entry &e) const noexcept {
+    return e.filled_Byte >= e.bytes.size();
+  }
+  // Caller holds mutex_.
+  void evictFor(const size_t size_Byte) noexcept;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<uint64_t, entry> entries;
+  std::list<uint64_t> lru; // most recent first
+  const size_t budget_Byte;
+  size_t cached_Byte = 0;
+  uint64_t sourceVersion = 0;
+
+  size_t hitNum = 0;
+  size_t missNum = 0;
+  perfStats saved;
+};
+
+} // namespace utils
+} // namespace MetaPB
+#endif
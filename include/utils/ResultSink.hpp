@@ -0,0 +1,86 @@
+#ifndef RESULT_SINK_HPP
+#define RESULT_SINK_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+
+#define SINK_WRITE_CHUNK_BYTE (8 << 20)
+#define SINK_STAGE_ALIGN_BYTE 4096
+
+namespace MetaPB {
+namespace utils {
+
+/// @brief Asynchronous file writer for graph outputs.
+// A stager thread copies submitted ranges chunk by chunk into two aligned
+// staging buffers while a writer thread pwrites the other one, so persisting
+// results overlaps with whatever the executor runs next. submit returns once
+// its range is staged, the caller may then reuse its pages. Files are
+// truncated when a stream is first opened.
+class ResultSink {
+public:
+  /// @brief Every stream lands in <dirPath>/<streamName>.bin
+  ResultSink(const std::string &dirPath) noexcept;
+  ResultSink(const ResultSink &) = delete;
+  ResultSink &operator=(const ResultSink &) = delete;
+  ~ResultSink() noexcept;
+
+  /// @brief Queue bytes of host memory to be written at fileOffset_Byte,
+  /// blocks until they are copied out of addr.
+  void submit(const std::string &streamName, const void *addr,
+              const size_t size_Byte, const off_t fileOffset_Byte) noexcept;
+
+  /// @brief Block until every submitted range is on its file.
+  void drain() noexcept;
+
+  inline size_t getWrittenSize_Byte() const noexcept { return written_Byte; }
+
+private:
+  typedef struct writeJob {
+    int fd;
+    const char *addr;
+    size_t size_Byte;
+    off_t fileOffset_Byte;
+  } writeJob;
+
+  // One chunk of a job, owned by the writer while isFull.
+  typedef struct stageBuffer {
+    char *data = nullptr;
+    int fd = -1;
+    size_t size_Byte = 0;
+    off_t fileOffset_Byte = 0;
+    bool isFull = false;
+  } stageBuffer;
+
+  int getStreamFd(const std::string &streamName) noexcept;
+  void stagerLoop() noexcept;
+  void writerLoop() noexcept;
+
+  std::string dirPath;
+  std::map<std::string, int> stream2Fd;
+  std::deque<writeJob> jobs;
+  stageBuffer stages[2];
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable staged_;
+  std::condition_variable stageFree_;
+  std::condition_variable stageFull_;
+  std::condition_variable drained_;
+  bool isStopping = false;
+  bool isStagerDone = false;
+  uint64_t submittedJobNum = 0;
+  uint64_t stagedJobNum = 0;
+  size_t written_Byte = 0;
+  std::thread stager;
+  std::thread writer;
+};
+
+} // namespace utils
+} // namespace MetaPB
+#endif
@@ -0,0 +1,406 @@
+#include "DPUEmu/dpu.h"
+#include "DPUEmu/dpu_emu_runtime.h"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstring>
+#include <dlfcn.h>
+#include <fstream>
+#include <iostream>
+#include <link.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <vector>
+
+// Calibration file, one row per kernel binary name:
+//   name,launch_us,MiB_per_sec
+// launch_us is the fixed cost of a launch, MiB_per_sec the MRAM traffic one
+// DPU sustains running that kernel. The row named XFER describes host<->MRAM
+// transfers, its MiB_per_sec being per rank. A DEFAULT row covers kernels
+// without their own row.
+#define DPU_EMU_CALIBRATION_PATH "/tmp/MetaPB/dpuEmu.csv"
+#define DPU_EMU_DPU_PER_RANK 64
+#define DPU_EMU_MRAM_BYTE (64ul << 20)
+#define DPU_EMU_WRAM_HEAP_BYTE (64ul << 10)
+#define DPU_EMU_DEFAULT_DPU_NUM 64
+
+extern "C" {
+__thread char *dpu_emu_mram = nullptr;
+__thread unsigned int dpu_emu_tasklet_id = 0;
+__thread size_t dpu_emu_mram_bytes = 0;
+}
+
+namespace {
+
+typedef struct calibration {
+  double launch_us;
+  double MiB_per_sec;
+} calibration;
+
+typedef struct program {
+  void *handle;
+  int (*entry)(void);
+  std::string name;
+  unsigned int taskletNum;
+} program;
+
+typedef struct emuDPU {
+  char *mram = nullptr;
+  const program *prog = nullptr;
+  std::map<std::string, std::vector<char>> hostVars;
+} emuDPU;
+
+} // namespace
+
+struct dpu_rank_t {
+  std::vector<emuDPU> dpus;
+};
+
+namespace {
+
+// Host API calls come from several executor threads, the emulated set runs
+// one of them at a time like a rank would.
+std::mutex emuMtx;
+std::vector<uint64_t> wramHeap(DPU_EMU_WRAM_HEAP_BYTE / sizeof(uint64_t));
+std::atomic<size_t> wramTop{0};
+std::unique_ptr<std::barrier<>> taskletBarrier;
+
+const std::map<std::string, calibration> &calibrations() noexcept {
+  static const std::map<std::string, calibration> table = [] {
+    std::map<std::string, calibration> rows;
+    const char *path = std::getenv("METAPB_DPU_EMU_CALIBRATION");
+    std::ifstream file(path != nullptr ? path : DPU_EMU_CALIBRATION_PATH);
+    std::string line;
+    while (std::getline(file, line)) {
+      char name[64];
+      calibration calib;
+      if (std::sscanf(line.c_str(), "%63[^,],%lf,%lf", name, &calib.launch_us,
+                      &calib.MiB_per_sec) == 3 &&
+          calib.MiB_per_sec > 0)
+        rows[name] = calib;
+    }
+    return rows;
+  }();
+  return table;
+}
+
+calibration calibrationOf(const std::string &name) noexcept {
+  const auto &table = calibrations();
+  if (table.contains(name))
+    return table.at(name);
+  if (name == "XFER")
+    return {20.0f, 350.0f};
+  if (table.contains("DEFAULT"))
+    return table.at("DEFAULT");
+  return {150.0f, 600.0f};
+}
+
+// Stretch an emulated operation to its calibrated duration. Host execution
+// slower than the model is left as is.
+void dilate(const std::chrono::steady_clock::time_point begin,
+            const double modeled_Second) noexcept {
+  static const bool isDilating = [] {
+    const char *env = std::getenv("METAPB_DPU_EMU_DILATION");
+    return env == nullptr || std::strcmp(env, "0") != 0;
+  }();
+  if (isDilating)
+    std::this_thread::sleep_until(
+        begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(modeled_Second)));
+}
+
+template <typename F>
+void forEachDPU(const struct dpu_set_t &set, F &&f) noexcept {
+  uint32_t dpuIdx = 0;
+  for (uint32_t rank = 0; rank < set.list.nr_ranks; rank++) {
+    for (auto &dpu : set.list.ranks[rank]->dpus)
+      f(dpu, dpuIdx++, rank);
+  }
+}
+
+size_t symbolSize(void *addr) noexcept {
+  Dl_info info;
+  const ElfW(Sym) *sym = nullptr;
+  if (dladdr1(addr, &info, (void **)&sym, RTLD_DL_SYMENT) == 0 ||
+      sym == nullptr)
+    return 0;
+  return sym->st_size;
+}
+
+// Tasklets are host threads sharing the DPU's MRAM, WRAM heap and barrier.
+size_t runDPU(emuDPU &dpu) noexcept {
+  const program &prog = *dpu.prog;
+  for (const auto &[name, bytes] : dpu.hostVars)
+    std::memcpy(dlsym(prog.handle, name.c_str()), bytes.data(), bytes.size());
+
+  wramTop = 0;
+  taskletBarrier = std::make_unique<std::barrier<>>(prog.taskletNum);
+  std::vector<size_t> traffic(prog.taskletNum, 0);
+  std::vector<std::thread> tasklets;
+  for (unsigned int t = 0; t < prog.taskletNum; t++) {
+    tasklets.emplace_back([&dpu, &prog, &traffic, t] {
+      dpu_emu_mram = dpu.mram;
+      dpu_emu_tasklet_id = t;
+      dpu_emu_mram_bytes = 0;
+      prog.entry();
+      traffic[t] = dpu_emu_mram_bytes;
+    });
+  }
+  for (auto &tasklet : tasklets)
+    tasklet.join();
+
+  for (auto &[name, bytes] : dpu.hostVars)
+    std::memcpy(bytes.data(), dlsym(prog.handle, name.c_str()), bytes.size());
+  size_t totalTraffic = 0;
+  for (const size_t bytes : traffic)
+    totalTraffic += bytes;
+  return totalTraffic;
+}
+
+double xferTime_Second(const std::vector<size_t> &rankBytes) noexcept {
+  const calibration calib = calibrationOf("XFER");
+  const size_t maxBytes = *std::max_element(rankBytes.begin(), rankBytes.end());
+  return calib.launch_us * 1e-6 + maxBytes / (calib.MiB_per_sec * (1 << 20));
+}
+
+} // namespace
+
+extern "C" {
+
+void *dpu_emu_mem_alloc(size_t size) {
+  size = (size + 7) & ~(size_t)7;
+  const size_t top = wramTop.fetch_add(size);
+  if (top + size > DPU_EMU_WRAM_HEAP_BYTE) {
+    std::cerr << "DPU emulator: WRAM heap exhausted" << std::endl;
+    return nullptr;
+  }
+  return (char *)wramHeap.data() + top;
+}
+
+void dpu_emu_mem_reset(void) { wramTop = 0; }
+
+void dpu_emu_barrier_wait(void) { taskletBarrier->arrive_and_wait(); }
+
+dpu_error_t dpu_alloc(uint32_t nr_dpus, const char *profile,
+                      struct dpu_set_t *dpu_set) {
+  (void)profile;
+  if (nr_dpus == DPU_ALLOCATE_ALL) {
+    const char *env = std::getenv("METAPB_DPU_EMU_NUM");
+    nr_dpus = env != nullptr ? std::atoi(env) : DPU_EMU_DEFAULT_DPU_NUM;
+  }
+  if (nr_dpus == 0)
+    return DPU_ERR_ALLOCATION;
+  const uint32_t rankNum =
+      (nr_dpus + DPU_EMU_DPU_PER_RANK - 1) / DPU_EMU_DPU_PER_RANK;
+  dpu_set->kind = DPU_SET_RANKS;
+  dpu_set->list.nr_ranks = rankNum;
+  dpu_set->list.ranks = new dpu_rank_t *[rankNum];
+  for (uint32_t rank = 0; rank < rankNum; rank++) {
+    dpu_set->list.ranks[rank] = new dpu_rank_t;
+    const uint32_t dpuNum = std::min<uint32_t>(
+        DPU_EMU_DPU_PER_RANK, nr_dpus - rank * DPU_EMU_DPU_PER_RANK);
+    dpu_set->list.ranks[rank]->dpus.resize(dpuNum);
+  }
+  bool isMapped = true;
+  forEachDPU(*dpu_set, [&isMapped](emuDPU &dpu, uint32_t, uint32_t) {
+    // Untouched MRAM costs nothing, only pages written by a job are backed.
+    void *mram = mmap(nullptr, DPU_EMU_MRAM_BYTE, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mram == MAP_FAILED)
+      isMapped = false;
+    else
+      dpu.mram = (char *)mram;
+  });
+  if (!isMapped) {
+    dpu_free(*dpu_set);
+    return DPU_ERR_ALLOCATION;
+  }
+  return DPU_OK;
+}
+
+dpu_error_t dpu_alloc_ranks(uint32_t nr_ranks, const char *profile,
+                            struct dpu_set_t *dpu_set) {
+  return dpu_alloc(nr_ranks * DPU_EMU_DPU_PER_RANK, profile, dpu_set);
+}
+
+dpu_error_t dpu_free(struct dpu_set_t dpu_set) {
+  if (dpu_set.kind != DPU_SET_RANKS)
+    return DPU_ERR_INTERNAL;
+  forEachDPU(dpu_set, [](emuDPU &dpu, uint32_t, uint32_t) {
+    if (dpu.mram != nullptr)
+      munmap(dpu.mram, DPU_EMU_MRAM_BYTE);
+  });
+  for (uint32_t rank = 0; rank < dpu_set.list.nr_ranks; rank++)
+    delete dpu_set.list.ranks[rank];
+  delete[] dpu_set.list.ranks;
+  return DPU_OK;
+}
+
+dpu_error_t dpu_get_nr_dpus(struct dpu_set_t dpu_set, uint32_t *nr_dpus) {
+  *nr_dpus = 0;
+  forEachDPU(dpu_set, [nr_dpus](emuDPU &, uint32_t, uint32_t) { (*nr_dpus)++; });
+  return DPU_OK;
+}
+
+dpu_error_t dpu_get_nr_ranks(struct dpu_set_t dpu_set, uint32_t *nr_ranks) {
+  *nr_ranks = dpu_set.list.nr_ranks;
+  return DPU_OK;
+}
+
+dpu_error_t dpu_load(struct dpu_set_t dpu_set, const char *binary_path,
+                     struct dpu_program_t **prog) {
+  static std::map<std::string, std::unique_ptr<program>> programs;
+  std::lock_guard<std::mutex> lock(emuMtx);
+  auto &loaded = programs[binary_path];
+  if (loaded == nullptr) {
+    void *handle = dlopen(binary_path, RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+      std::cerr << "DPU emulator: " << dlerror() << std::endl;
+      programs.erase(binary_path);
+      return DPU_ERR_ELF_INVALID_FILE;
+    }
+    const auto *taskletNum =
+        (const unsigned int *)dlsym(handle, "dpu_emu_nr_tasklets");
+    const std::string path = binary_path;
+    loaded = std::make_unique<program>(program{
+        handle, (int (*)(void))dlsym(handle, "main"),
+        path.substr(path.find_last_of('/') + 1),
+        taskletNum != nullptr ? *taskletNum : 12});
+  }
+  forEachDPU(dpu_set, [&loaded](emuDPU &dpu, uint32_t, uint32_t) {
+    dpu.prog = loaded.get();
+    dpu.hostVars.clear();
+  });
+  if (prog != nullptr)
+    *prog = (struct dpu_program_t *)loaded.get();
+  return DPU_OK;
+}
+
+dpu_error_t dpu_broadcast_to(struct dpu_set_t dpu_set, const char *symbol_name,
+                             uint32_t symbol_offset, const void *src,
+                             size_t length, dpu_xfer_flags_t flags) {
+  (void)flags;
+  std::lock_guard<std::mutex> lock(emuMtx);
+  const auto begin = std::chrono::steady_clock::now();
+  const bool isMRAM = std::strcmp(symbol_name, "buffer") == 0;
+  if (isMRAM && symbol_offset + length > DPU_EMU_MRAM_BYTE)
+    return DPU_ERR_INVALID_MEMORY_TRANSFER;
+  dpu_error_t status = DPU_OK;
+  std::vector<size_t> rankBytes(dpu_set.list.nr_ranks, 0);
+  forEachDPU(dpu_set, [&](emuDPU &dpu, uint32_t, uint32_t rank) {
+    rankBytes[rank] += length;
+    if (isMRAM) {
+      std::memcpy(dpu.mram + symbol_offset, src, length);
+      return;
+    }
+    void *sym = dpu.prog != nullptr ? dlsym(dpu.prog->handle, symbol_name)
+                                    : nullptr;
+    const size_t symSize = sym != nullptr ? symbolSize(sym) : 0;
+    if (symbol_offset + length > symSize) {
+      status = DPU_ERR_INVALID_SYMBOL_ACCESS;
+      return;
+    }
+    auto &bytes = dpu.hostVars[symbol_name];
+    if (bytes.size() != symSize) {
+      bytes.resize(symSize);
+      std::memcpy(bytes.data(), sym, symSize);
+    }
+    std::memcpy(bytes.data() + symbol_offset, src, length);
+  });
+  if (status == DPU_OK)
+    dilate(begin, xferTime_Second(rankBytes));
+  return status;
+}
+
+dpu_error_t dpu_launch(struct dpu_set_t dpu_set, dpu_launch_policy_t policy) {
+  (void)policy; // asynchronous launches complete before returning
+  std::lock_guard<std::mutex> lock(emuMtx);
+  const auto begin = std::chrono::steady_clock::now();
+  dpu_error_t status = DPU_OK;
+  double maxDPU_Second = 0.0f;
+  double launch_us = 0.0f;
+  forEachDPU(dpu_set, [&](emuDPU &dpu, uint32_t, uint32_t) {
+    if (dpu.prog == nullptr || dpu.prog->entry == nullptr) {
+      status = DPU_ERR_INTERNAL;
+      return;
+    }
+    // DPUs run side by side on hardware, the slowest one sets the pace.
+    const calibration calib = calibrationOf(dpu.prog->name);
+    launch_us = std::max(launch_us, calib.launch_us);
+    maxDPU_Second = std::max(maxDPU_Second,
+                             runDPU(dpu) / (calib.MiB_per_sec * (1 << 20)));
+  });
+  if (status == DPU_OK)
+    dilate(begin, launch_us * 1e-6 + maxDPU_Second);
+  return status;
+}
+
+dpu_error_t dpu_sync(struct dpu_set_t dpu_set) {
+  (void)dpu_set;
+  return DPU_OK;
+}
+
+dpu_error_t dpu_push_sg_xfer(struct dpu_set_t dpu_set, dpu_xfer_t xfer,
+                             const char *symbol_name, uint32_t symbol_offset,
+                             size_t length, get_block_t *get_block_info,
+                             dpu_sg_xfer_flags_t flags) {
+  if (std::strcmp(symbol_name, "buffer") != 0)
+    return DPU_ERR_INVALID_SYMBOL_ACCESS;
+  if (symbol_offset + length > DPU_EMU_MRAM_BYTE)
+    return DPU_ERR_INVALID_MEMORY_TRANSFER;
+  std::lock_guard<std::mutex> lock(emuMtx);
+  const auto begin = std::chrono::steady_clock::now();
+  const bool isLengthChecked = !(flags & DPU_SG_XFER_DISABLE_LENGTH_CHECK);
+  dpu_error_t status = DPU_OK;
+  std::vector<size_t> rankBytes(dpu_set.list.nr_ranks, 0);
+  forEachDPU(dpu_set, [&](emuDPU &dpu, uint32_t dpuIdx, uint32_t rank) {
+    size_t movedBytes = 0;
+    struct sg_block_info block;
+    for (uint32_t blockIdx = 0;
+         get_block_info->f(&block, dpuIdx, blockIdx, get_block_info->args);
+         blockIdx++) {
+      if (movedBytes + block.length > length) {
+        status = DPU_ERR_INVALID_MEMORY_TRANSFER;
+        return;
+      }
+      char *mram = dpu.mram + symbol_offset + movedBytes;
+      if (xfer == DPU_XFER_TO_DPU)
+        std::memcpy(mram, block.addr, block.length);
+      else
+        std::memcpy(block.addr, mram, block.length);
+      movedBytes += block.length;
+    }
+    if (isLengthChecked && movedBytes != length)
+      status = DPU_ERR_INVALID_MEMORY_TRANSFER;
+    rankBytes[rank] += movedBytes;
+  });
+  if (status == DPU_OK)
+    dilate(begin, xferTime_Second(rankBytes));
+  return status;
+}
+
+const char *dpu_error_to_string(dpu_error_t status) {
+  switch (status) {
+  case DPU_OK:
+    return "success";
+  case DPU_ERR_SYSTEM:
+    return "system error";
+  case DPU_ERR_ALLOCATION:
+    return "allocation error";
+  case DPU_ERR_INVALID_SYMBOL_ACCESS:
+    return "invalid symbol access";
+  case DPU_ERR_INVALID_MEMORY_TRANSFER:
+    return "invalid memory transfer";
+  case DPU_ERR_ELF_INVALID_FILE:
+    return "invalid program file";
+  default:
+    return "internal error";
+  }
+}
+
+} // extern "C"
@@ -0,0 +1,63 @@
+#include "Distributed/Coordinator.hpp"
+
+namespace MetaPB {
+namespace Distributed {
+
+Coordinator::Coordinator(const std::vector<std::string> &workerEndpoints,
+                         const NetworkModel &net,
+                         const uint32_t dpuNum) noexcept
+    : net(net), dpuNum(dpuNum) {
+  for (const auto &endpoint : workerEndpoints) {
+    auto transport = SocketTransport::connectTo(endpoint);
+    if (transport != nullptr)
+      validWorkerNum++;
+    workers.push_back(std::move(transport));
+  }
+}
+
+perfStats Coordinator::execWorkload(const TaskGraph &tg, const Schedule &sched,
+                                    execType eT) noexcept {
+  const uint32_t nodeNum = workers.size();
+  if (!isValid()) {
+    std::cerr << "Coordinator: " << nodeNum - validWorkerNum
+              << " worker(s) unreachable" << std::endl;
+    return {};
+  }
+  const MsgKind kind =
+      eT == execType::DO ? MsgKind::EXEC_DO : MsgKind::EXEC_MIMIC;
+
+  // Ship every partition first so workers run concurrently.
+  for (uint32_t i = 0; i < nodeNum; i++) {
+    std::vector<char> job;
+    WireWriter w(job);
+    encodeGraph(w, partitionGraph(tg, i, nodeNum));
+    encodeSchedule(w, sched);
+    if (!workers[i]->sendFrame(kind, job)) {
+      std::cerr << "Coordinator: lost worker " << i << std::endl;
+      return {};
+    }
+  }
+
+  std::vector<perfStats> nodeStats(nodeNum);
+  for (uint32_t i = 0; i < nodeNum; i++) {
+    MsgKind replyKind;
+    std::vector<char> reply;
+    WireReader r(reply);
+    if (!workers[i]->recvFrame(replyKind, reply) ||
+        replyKind != MsgKind::RESULT || !decodePerf(r, nodeStats[i])) {
+      std::cerr << "Coordinator: bad reply from worker " << i << std::endl;
+      return {};
+    }
+  }
+  return deduceCluster(nodeStats, net, boundaryXfer_MiB(tg, dpuNum));
+}
+
+void Coordinator::shutdownWorkers() noexcept {
+  for (auto &worker : workers) {
+    if (worker != nullptr)
+      worker->sendFrame(MsgKind::SHUTDOWN, {});
+  }
+}
+
+} // namespace Distributed
+} // namespace MetaPB
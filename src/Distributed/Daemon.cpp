@@ -0,0 +1,188 @@
+#include "Distributed/Daemon.hpp"
+#include "Scheduler/HEFTScheduler.hpp"
+#include "Scheduler/MetaScheduler.hpp"
+#include <algorithm>
+
+namespace MetaPB {
+namespace Distributed {
+
+void encodeJob(WireWriter &w, const daemonJob &job) noexcept {
+  encodeGraph(w, job.tg);
+  w.put<uint8_t>((uint8_t)job.eT);
+  w.put<uint8_t>((uint8_t)job.schedKind);
+  if (job.schedKind == SchedulerKind::GIVEN)
+    encodeSchedule(w, job.sched);
+  w.put<double>(job.alpha);
+  w.put<double>(job.beta);
+  w.put<uint32_t>(job.optIterMax);
+  w.putString(job.datasetPath);
+  w.putString(job.sinkDir);
+}
+
+bool decodeJob(WireReader &r, daemonJob &job) noexcept {
+  if (!decodeGraph(r, job.tg))
+    return false;
+  job.eT = (execType)r.get<uint8_t>();
+  job.schedKind = (SchedulerKind)r.get<uint8_t>();
+  if (job.schedKind == SchedulerKind::GIVEN && !decodeSchedule(r, job.sched))
+    return false;
+  job.alpha = r.get<double>();
+  job.beta = r.get<double>();
+  job.optIterMax = r.get<uint32_t>();
+  job.datasetPath = r.getString();
+  job.sinkDir = r.getString();
+  return r.isValid();
+}
+
+void encodeReply(WireWriter &w, const daemonReply &reply) noexcept {
+  encodePerf(w, reply.perf);
+  encodeSchedule(w, reply.sched);
+  w.put<uint8_t>(reply.isScheduleCached);
+}
+
+bool decodeReply(WireReader &r, daemonReply &reply) noexcept {
+  if (!decodePerf(r, reply.perf) || !decodeSchedule(r, reply.sched))
+    return false;
+  reply.isScheduleCached = r.get<uint8_t>();
+  return r.isValid();
+}
+
+namespace {
+// FNV-1a, same graph + same scheduler knobs hit the schedule cache.
+uint64_t fingerprint(const std::vector<char> &payload) noexcept {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (const char c : payload) {
+    hash ^= (uint8_t)c;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+} // namespace
+
+void Daemon::warmModels(const TaskGraph &tg) noexcept {
+  regressionTask task = tg.genRegressionTask();
+  const std::set<int> elemTypes = tg.genElemTypes();
+  bool isCold = !std::includes(trainedElemTypes.begin(), trainedElemTypes.end(),
+                               elemTypes.begin(), elemTypes.end());
+  for (const auto &[opTag, upperBound_MiB] : task) {
+    if (!trainedUpperBound_MiB.contains(opTag) ||
+        trainedUpperBound_MiB[opTag] < upperBound_MiB)
+      isCold = true;
+  }
+  if (!isCold)
+    return;
+  om.trainModel(task, elemTypes);
+  trainedElemTypes.insert(elemTypes.begin(), elemTypes.end());
+  for (const auto &[opTag, upperBound_MiB] : task) {
+    trainedUpperBound_MiB[opTag] =
+        std::max(trainedUpperBound_MiB[opTag], upperBound_MiB);
+  }
+}
+
+daemonReply Daemon::handleJob(const daemonJob &job) noexcept {
+  daemonReply reply;
+  warmModels(job.tg);
+  // Before scheduling, the schedule is priced on the geometry it runs on.
+  om.fitRanks(job.tg);
+
+  if (job.schedKind == SchedulerKind::GIVEN) {
+    reply.sched = job.sched;
+  } else {
+    // Execution mode does not change the schedule, keep it out of the key.
+    std::vector<char> keyPayload;
+    WireWriter w(keyPayload);
+    encodeGraph(w, job.tg);
+    w.put<uint8_t>((uint8_t)job.schedKind);
+    w.put<double>(job.alpha);
+    w.put<double>(job.beta);
+    w.put<uint32_t>(job.optIterMax);
+    const uint64_t key = fingerprint(keyPayload);
+    if (scheduleCache.contains(key)) {
+      reply.sched = scheduleCache[key];
+      reply.isScheduleCached = true;
+    } else {
+      if (job.schedKind == SchedulerKind::HEFT) {
+        Scheduler::HEFTScheduler heft(job.tg, om);
+        reply.sched = heft.schedule();
+      } else {
+        Scheduler::MetaScheduler meta(job.alpha, job.beta, job.optIterMax,
+                                      job.tg, om);
+        reply.sched = meta.schedule();
+      }
+      scheduleCache[key] = reply.sched;
+    }
+  }
+
+  HeteroComputePool hcp(om, memPoolPtr);
+  std::unique_ptr<DatasetSource> dataset;
+  if (job.eT == execType::DO && !job.datasetPath.empty()) {
+    dataset =
+        std::make_unique<DatasetSource>(job.datasetPath, om.getPageBlkSize());
+    if (!hcp.bindDataset(job.tg, dataset.get()))
+      std::cerr << "MetaPBd: " << job.datasetPath
+                << " does not fit the graph, feeding from the pool"
+                << std::endl;
+  }
+  // Destroyed before the reply, every output is on its file by then.
+  std::unique_ptr<ResultSink> sink;
+  if (job.eT == execType::DO && !job.sinkDir.empty()) {
+    sink = std::make_unique<ResultSink>(job.sinkDir);
+    hcp.bindSink(sink.get());
+  }
+  reply.perf = hcp.execWorkload(job.tg, reply.sched, job.eT);
+  return reply;
+}
+
+void Daemon::serve(const std::string &endpoint) noexcept {
+  SocketListener listener(endpoint);
+  if (!listener.isValid())
+    return;
+  std::cout << "MetaPBd listening on " << endpoint << std::endl;
+  while (!isShuttingDown) {
+    auto peer = listener.accept();
+    if (peer == nullptr)
+      continue;
+    MsgKind kind;
+    std::vector<char> payload;
+    while (peer->recvFrame(kind, payload)) {
+      if (kind == MsgKind::SHUTDOWN) {
+        isShuttingDown = true;
+        break;
+      }
+      daemonJob job;
+      WireReader r(payload);
+      if (kind != MsgKind::SUBMIT || !decodeJob(r, job)) {
+        std::cerr << "MetaPBd: malformed request, dropping client"
+                  << std::endl;
+        break;
+      }
+      std::vector<char> reply;
+      WireWriter w(reply);
+      encodeReply(w, handleJob(job));
+      if (!peer->sendFrame(MsgKind::RESULT, reply))
+        break;
+    }
+  }
+}
+
+bool DaemonClient::submit(const daemonJob &job, daemonReply &reply) noexcept {
+  if (!isValid())
+    return false;
+  std::vector<char> payload;
+  WireWriter w(payload);
+  encodeJob(w, job);
+  MsgKind kind;
+  std::vector<char> answer;
+  WireReader r(answer);
+  return peer->sendFrame(MsgKind::SUBMIT, payload) &&
+         peer->recvFrame(kind, answer) && kind == MsgKind::RESULT &&
+         decodeReply(r, reply);
+}
+
+void DaemonClient::shutdownDaemon() noexcept {
+  if (isValid())
+    peer->sendFrame(MsgKind::SHUTDOWN, {});
+}
+
+} // namespace Distributed
+} // namespace MetaPB
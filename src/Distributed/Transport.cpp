@@ -0,0 +1,225 @@
+#include "Distributed/Transport.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace MetaPB {
+namespace Distributed {
+
+namespace {
+
+typedef struct endpointInfo {
+  bool isUnix = false;
+  std::string path; // unix only
+  std::string host; // tcp only
+  std::string port; // tcp only
+} endpointInfo;
+
+bool parseEndpoint(const std::string &endpoint, endpointInfo &info) noexcept {
+  if (endpoint.starts_with("unix:")) {
+    info.isUnix = true;
+    info.path = endpoint.substr(5);
+    return !info.path.empty() &&
+           info.path.size() < sizeof(sockaddr_un::sun_path);
+  }
+  if (endpoint.starts_with("tcp:")) {
+    size_t colon = endpoint.rfind(':');
+    if (colon <= 3)
+      return false;
+    info.host = endpoint.substr(4, colon - 4);
+    info.port = endpoint.substr(colon + 1);
+    return !info.port.empty();
+  }
+  return false;
+}
+
+sockaddr_un unixAddr(const std::string &path) noexcept {
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  return addr;
+}
+
+} // namespace
+
+bool Transport::sendFrame(const MsgKind kind,
+                          const std::vector<char> &payload) noexcept {
+  uint32_t kindRaw = (uint32_t)kind;
+  uint64_t size_Byte = payload.size();
+  if (size_Byte > TRANSPORT_MAX_FRAME_BYTE)
+    return false;
+  return sendAll(&kindRaw, sizeof(kindRaw)) &&
+         sendAll(&size_Byte, sizeof(size_Byte)) &&
+         sendAll(payload.data(), payload.size());
+}
+
+bool Transport::recvFrame(MsgKind &kind, std::vector<char> &payload) noexcept {
+  uint32_t kindRaw;
+  uint64_t size_Byte;
+  if (!recvAll(&kindRaw, sizeof(kindRaw)) ||
+      !recvAll(&size_Byte, sizeof(size_Byte)))
+    return false;
+  kind = kindRaw < (uint32_t)MsgKind::UNDEFINED ? (MsgKind)kindRaw
+                                                : MsgKind::UNDEFINED;
+  // The length comes off the wire, it is checked before it sizes anything.
+  if (size_Byte > TRANSPORT_MAX_FRAME_BYTE) {
+    std::cerr << "Transport: refusing a " << size_Byte << " byte frame"
+              << std::endl;
+    return false;
+  }
+  payload.resize(size_Byte);
+  return recvAll(payload.data(), size_Byte);
+}
+
+SocketTransport::~SocketTransport() noexcept {
+  if (fd >= 0)
+    close(fd);
+}
+
+bool SocketTransport::sendAll(const void *buf,
+                              const size_t size_Byte) noexcept {
+  const char *p = (const char *)buf;
+  size_t done = 0;
+  while (done < size_Byte) {
+    ssize_t ret = send(fd, p + done, size_Byte - done, MSG_NOSIGNAL);
+    if (ret < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    done += ret;
+  }
+  return true;
+}
+
+bool SocketTransport::recvAll(void *buf, const size_t size_Byte) noexcept {
+  char *p = (char *)buf;
+  size_t done = 0;
+  while (done < size_Byte) {
+    ssize_t ret = recv(fd, p + done, size_Byte - done, 0);
+    if (ret < 0 && errno == EINTR)
+      continue;
+    if (ret <= 0) // error or peer closed
+      return false;
+    done += ret;
+  }
+  return true;
+}
+
+std::unique_ptr<SocketTransport>
+SocketTransport::connectTo(const std::string &endpoint) noexcept {
+  endpointInfo info;
+  if (!parseEndpoint(endpoint, info)) {
+    std::cerr << "Transport: malformed endpoint " << endpoint << std::endl;
+    return nullptr;
+  }
+  if (info.isUnix) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr = unixAddr(info.path);
+    if (fd < 0 || connect(fd, (sockaddr *)&addr, sizeof(addr)) != 0) {
+      std::cerr << "Transport: cannot connect " << endpoint << ": "
+                << strerror(errno) << std::endl;
+      if (fd >= 0)
+        close(fd);
+      return nullptr;
+    }
+    return std::make_unique<SocketTransport>(fd);
+  }
+
+  addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *res = nullptr;
+  if (getaddrinfo(info.host.c_str(), info.port.c_str(), &hints, &res) != 0) {
+    std::cerr << "Transport: cannot resolve " << endpoint << std::endl;
+    return nullptr;
+  }
+  int fd = -1;
+  for (addrinfo *ai = res; ai != nullptr; ai = ai->ai_next) {
+    fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0)
+      continue;
+    if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+      break;
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  if (fd < 0) {
+    std::cerr << "Transport: cannot connect " << endpoint << std::endl;
+    return nullptr;
+  }
+  // Frames are small headers followed by bulk payload, don't batch them.
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  return std::make_unique<SocketTransport>(fd);
+}
+
+SocketListener::SocketListener(const std::string &endpoint) noexcept
+    : endpoint(endpoint) {
+  endpointInfo info;
+  if (!parseEndpoint(endpoint, info)) {
+    std::cerr << "Transport: malformed endpoint " << endpoint << std::endl;
+    return;
+  }
+  if (info.isUnix) {
+    unlink(info.path.c_str()); // stale socket of a previous run
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr = unixAddr(info.path);
+    if (fd >= 0 && bind(fd, (sockaddr *)&addr, sizeof(addr)) == 0 &&
+        listen(fd, SOMAXCONN) == 0)
+      return;
+  } else {
+    fd = socket(AF_INET6, SOCK_STREAM, 0);
+    int one = 1, zero = 0;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero));
+    sockaddr_in6 addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_addr = in6addr_any;
+    addr.sin6_port = htons(atoi(info.port.c_str()));
+    if (fd >= 0 && bind(fd, (sockaddr *)&addr, sizeof(addr)) == 0 &&
+        listen(fd, SOMAXCONN) == 0)
+      return;
+  }
+  std::cerr << "Transport: cannot listen on " << endpoint << ": "
+            << strerror(errno) << std::endl;
+  if (fd >= 0)
+    close(fd);
+  fd = -1;
+}
+
+SocketListener::~SocketListener() noexcept {
+  if (fd < 0)
+    return;
+  close(fd);
+  endpointInfo info;
+  if (parseEndpoint(endpoint, info) && info.isUnix)
+    unlink(info.path.c_str());
+}
+
+std::unique_ptr<SocketTransport> SocketListener::accept() noexcept {
+  int peer;
+  do {
+    peer = ::accept(fd, nullptr, nullptr);
+  } while (peer < 0 && errno == EINTR);
+  if (peer < 0) {
+    std::cerr << "Transport: accept failed on " << endpoint << ": "
+              << strerror(errno) << std::endl;
+    return nullptr;
+  }
+  return std::make_unique<SocketTransport>(peer);
+}
+
+} // namespace Distributed
+} // namespace MetaPB
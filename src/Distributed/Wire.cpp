@@ -0,0 +1,123 @@
+#include "Distributed/Wire.hpp"
+
+namespace MetaPB {
+namespace Distributed {
+
+using Executor::Graph;
+using Executor::TaskProperties;
+using Executor::TransferProperties;
+
+void encodeGraph(WireWriter &w, const TaskGraph &tg) noexcept {
+  const Graph &g = tg.g;
+  w.put<uint32_t>(WIRE_MAGIC);
+  w.put<uint32_t>(WIRE_VERSION);
+  w.putString(tg.getName());
+
+  w.put<uint32_t>(boost::num_vertices(g));
+  auto vertices = boost::vertices(g);
+  for (auto vi = vertices.first; vi != vertices.second; ++vi) {
+    const TaskProperties &tp = g[*vi];
+    w.put<uint32_t>((uint32_t)tp.op);
+    w.put<uint32_t>((uint32_t)tp.opType);
+    w.put<uint64_t>(tp.inputSize_MiB);
+    w.put<int32_t>(tp.elemType);
+    w.putString(tp.color);
+    w.putString(tp.name);
+    w.put<uint8_t>(tp.isCPUOnly);
+    w.put<uint8_t>(tp.isDPUOnly);
+    w.put<double>(tp.offloadRatio);
+    w.put<double>(tp.xferCompressRatio);
+  }
+
+  w.put<uint32_t>(boost::num_edges(g));
+  auto edges = boost::edges(g);
+  for (auto ei = edges.first; ei != edges.second; ++ei) {
+    const TransferProperties &xp = g[*ei];
+    w.put<uint32_t>(boost::source(*ei, g));
+    w.put<uint32_t>(boost::target(*ei, g));
+    w.put<double>(xp.dataSize_Ratio);
+    w.put<uint8_t>(xp.isNeedTransfer);
+    w.put<double>(xp.prevDRAMRatio);
+    w.put<double>(xp.nextDRAMRatio);
+    w.put<uint8_t>(xp.isBroadcast);
+  }
+}
+
+bool decodeGraph(WireReader &r, TaskGraph &tg) noexcept {
+  if (r.get<uint32_t>() != WIRE_MAGIC || r.get<uint32_t>() != WIRE_VERSION)
+    return false;
+  const std::string name = r.getString();
+
+  Graph g;
+  const uint32_t vertexNum = r.get<uint32_t>();
+  for (uint32_t i = 0; i < vertexNum && r.isValid(); i++) {
+    TaskProperties tp;
+    tp.op = (OperatorTag)r.get<uint32_t>();
+    tp.opType = (OperatorType)r.get<uint32_t>();
+    tp.inputSize_MiB = r.get<uint64_t>();
+    tp.elemType = r.get<int32_t>();
+    tp.color = r.getString();
+    tp.name = r.getString();
+    tp.isCPUOnly = r.get<uint8_t>();
+    tp.isDPUOnly = r.get<uint8_t>();
+    tp.offloadRatio = r.get<double>();
+    tp.xferCompressRatio = r.get<double>();
+    boost::add_vertex(tp, g);
+  }
+
+  const uint32_t edgeNum = r.get<uint32_t>();
+  for (uint32_t i = 0; i < edgeNum && r.isValid(); i++) {
+    const uint32_t src = r.get<uint32_t>();
+    const uint32_t dst = r.get<uint32_t>();
+    TransferProperties xp;
+    xp.dataSize_Ratio = r.get<double>();
+    xp.isNeedTransfer = r.get<uint8_t>();
+    xp.prevDRAMRatio = r.get<double>();
+    xp.nextDRAMRatio = r.get<double>();
+    xp.isBroadcast = r.get<uint8_t>();
+    if (src >= vertexNum || dst >= vertexNum)
+      return false;
+    boost::add_edge(src, dst, xp, g);
+  }
+  if (!r.isValid())
+    return false;
+  tg = TaskGraph(g, name);
+  return true;
+}
+
+void encodeSchedule(WireWriter &w, const Schedule &sched) noexcept {
+  w.put<uint8_t>(sched.isAlwaysWrittingBack);
+  w.put<uint32_t>(sched.order.size());
+  for (const int taskId : sched.order)
+    w.put<int32_t>(taskId);
+  w.put<uint32_t>(sched.offloadRatio.size());
+  for (const float ratio : sched.offloadRatio)
+    w.put<float>(ratio);
+}
+
+bool decodeSchedule(WireReader &r, Schedule &sched) noexcept {
+  sched.isAlwaysWrittingBack = r.get<uint8_t>();
+  sched.order.resize(r.get<uint32_t>());
+  for (size_t i = 0; i < sched.order.size() && r.isValid(); i++)
+    sched.order[i] = r.get<int32_t>();
+  sched.offloadRatio.resize(r.get<uint32_t>());
+  for (size_t i = 0; i < sched.offloadRatio.size() && r.isValid(); i++)
+    sched.offloadRatio[i] = r.get<float>();
+  return r.isValid();
+}
+
+void encodePerf(WireWriter &w, const perfStats &perf) noexcept {
+  w.put<double>(perf.energyCost_Joule);
+  w.put<double>(perf.timeCost_Second);
+  w.put<double>(perf.dataMovement_MiB);
+}
+
+bool decodePerf(WireReader &r, perfStats &perf) noexcept {
+  perf.energyCost_Joule = r.get<double>();
+  perf.timeCost_Second = r.get<double>();
+  perf.dataMovement_MiB = r.get<double>();
+  return r.isValid();
+}
+
+} // namespace Distributed
+} // namespace MetaPB
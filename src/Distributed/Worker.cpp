@@ -0,0 +1,56 @@
+#include "Distributed/Worker.hpp"
+
+namespace MetaPB {
+namespace Distributed {
+
+void Worker::serve(const std::string &endpoint) noexcept {
+  SocketListener listener(endpoint);
+  if (!listener.isValid())
+    return;
+  std::cout << "Worker listening on " << endpoint << std::endl;
+  while (!isShuttingDown) {
+    auto peer = listener.accept();
+    if (peer == nullptr)
+      continue;
+    MsgKind kind;
+    std::vector<char> payload;
+    while (peer->recvFrame(kind, payload) &&
+           handleFrame(*peer, kind, payload)) {
+    }
+  }
+}
+
+bool Worker::handleFrame(Transport &peer, const MsgKind kind,
+                         const std::vector<char> &payload) noexcept {
+  switch (kind) {
+  case MsgKind::EXEC_MIMIC:
+  case MsgKind::EXEC_DO: {
+    WireReader r(payload);
+    TaskGraph tg;
+    Schedule sched;
+    if (!decodeGraph(r, tg) || !decodeSchedule(r, sched)) {
+      std::cerr << "Worker: malformed job, dropping session" << std::endl;
+      return false;
+    }
+    HeteroComputePool hcp(om, memPoolPtr);
+    const perfStats perf = hcp.execWorkload(
+        tg, sched,
+        kind == MsgKind::EXEC_DO ? Executor::execType::DO
+                                 : Executor::execType::MIMIC);
+    std::vector<char> reply;
+    WireWriter w(reply);
+    encodePerf(w, perf);
+    return peer.sendFrame(MsgKind::RESULT, reply);
+  }
+  case MsgKind::SHUTDOWN:
+    isShuttingDown = true;
+    return false;
+  default:
+    std::cerr << "Worker: unexpected message kind " << (uint32_t)kind
+              << std::endl;
+    return false;
+  }
+}
+
+} // namespace Distributed
+} // namespace MetaPB
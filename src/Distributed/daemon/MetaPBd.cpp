@@ -0,0 +1,29 @@
+#include "Distributed/Daemon.hpp"
+#include <cstdlib>
+#include <iostream>
+
+// Usage: MetaPBd [endpoint] [memPool_GiB]
+int main(int argc, char **argv) {
+  const std::string endpoint =
+      argc > 1 ? argv[1] : "unix:/tmp/MetaPB/MetaPBd.sock";
+  const size_t memPool_GiB = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+
+  void **memPool = (void **)malloc(3 * sizeof(void *));
+  memPool[0] = malloc(memPool_GiB * size_t(1 << 30));
+  if (memPool[0] == nullptr) {
+    std::cerr << "MetaPBd: cannot allocate " << memPool_GiB << "GiB pool"
+              << std::endl;
+    return 1;
+  }
+  memPool[1] = memPool[0];
+  memPool[2] = memPool[0];
+
+  {
+    MetaPB::Distributed::Daemon daemon(memPool);
+    daemon.serve(endpoint);
+  }
+
+  free(memPool[0]);
+  free((void *)memPool);
+  return 0;
+}
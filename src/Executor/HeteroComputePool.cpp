@@ -1,4 +1,5 @@
 #include "Executor/HeteroComputePool.hpp"
+#include <cstdlib>
 
 namespace MetaPB {
 namespace Executor {
@@ -72,7 +73,9 @@ void HeteroComputePool::processTasks(
 std::pair<Task, Task>
 HeteroComputePool::genComputeTask(int taskId, OperatorTag opTag, OperatorType opType,
                                        const CPU_TCB& cpuTCB, const DPU_TCB& dpuTCB,
-                                       execType eT) noexcept{
+                                       execType eT, uint32_t fusedStageNum,
+                                       uint32_t dpuChainStageNum,
+                                       int elemType) noexcept{
   Task cpuTask, dpuTask;
   std::string opTypeStr = opType2Name.at(opType);
 
@@ -87,27 +90,30 @@ HeteroComputePool::genComputeTask(int taskId, OperatorTag opTag, OperatorType op
   if (eT == execType::DO) {
     cpuTask = {false,
                taskId,
-               [this, opTag, cpuTCB]() {
+               [this, opTag, cpuTCB, elemType]() {
                  if (cpuTCB.pageBlkCnt)
-                   om.execCPU(opTag, cpuTCB);
+                   om.execCPU(opTag, cpuTCB, elemType);
                },
                opTypeStr};
 
     dpuTask = {true, taskId,
-               [this, opTag, dpuTCB]() {
+               [this, opTag, dpuTCB, elemType]() {
                  if (dpuTCB.pageCnt)
-                   om.execDPU(opTag, dpuTCB);
+                   om.execDPU(opTag, dpuTCB, elemType);
                },
                opTypeStr};
 
   } else { // MIMIC logic
     cpuTask = {false,
                taskId,
-               [this, taskId, opTag, pageBlkCnt=cpuTCB.pageBlkCnt]() {
+               [this, taskId, opTag, pageBlkCnt=cpuTCB.pageBlkCnt,
+                fusedStageNum, elemType]() {
+                 // A fused chain head is priced for the whole chain.
                  const auto perf =
-                    pageBlkCnt 
-                         ? om.deducePerfCPU(opTag, pageBlkCnt)
-                         : perfStats{};
+                    !pageBlkCnt ? perfStats{}
+                    : fusedStageNum
+                         ? om.deducePerfFusedCPU(fusedStageNum, pageBlkCnt)
+                         : om.deducePerfCPU(opTag, pageBlkCnt, elemType);
                  // ------------- critical zone --------------
                  {
                    std::lock_guard<std::mutex> lock(this->mutex_);
@@ -123,11 +129,14 @@ HeteroComputePool::genComputeTask(int taskId, OperatorTag opTag, OperatorType op
 
     dpuTask = {true,
                taskId,
-               [this, taskId, opTag, pageBlkCnt=dpuTCB.pageCnt]() {
-                 const auto perf = 
-                    pageBlkCnt 
-                         ? om.deducePerfDPU(opTag, pageBlkCnt)
-                         : perfStats{};
+               [this, taskId, opTag, pageBlkCnt=dpuTCB.pageCnt,
+                dpuChainStageNum, elemType]() {
+                 // A chain head launches, and is priced for, the whole chain.
+                 const auto perf =
+                    !pageBlkCnt ? perfStats{}
+                    : dpuChainStageNum
+                         ? om.deducePerfFusedDPU(dpuChainStageNum, pageBlkCnt)
+                         : om.deducePerfDPU(opTag, pageBlkCnt, elemType);
                  // ------------- critical zone --------------
                  {
                    std::lock_guard<std::mutex> lock(this->mutex_);
@@ -145,8 +154,386 @@ HeteroComputePool::genComputeTask(int taskId, OperatorTag opTag, OperatorType op
   return {cpuTask, dpuTask};
 }
 
+std::vector<int> HeteroComputePool::planElemwiseFusion(
+    const TaskGraph &g, const Schedule &sched,
+    const std::vector<uint32_t> &cpuPageBlkCnts,
+    const std::vector<uint32_t> &dpuPageBlkCnts) const noexcept {
+  const int taskNum = sched.order.size();
+  // A broadcast producer has to leave its output on the host.
+  auto isFusible = [&](const int taskId) {
+    return Operator::elemwiseOPSet.contains(g.g[taskId].op) &&
+           g.g[taskId].elemType == INT32_32ALN &&
+           cpuPageBlkCnts[taskId] > 0 && !isOutputCached_[taskId] &&
+           bcastPageCnt_[taskId] == 0;
+  };
+
+  std::vector<int> fusedHead(taskNum, -1);
+  std::vector<int> chainSize(taskNum, 0);
+  for (const int taskId : sched.order) {
+    if (!isFusible(taskId))
+      continue;
+    fusedHead[taskId] = taskId;
+    if (boost::in_degree(taskId, g.g) == 1) {
+      TaskNode pred = boost::source(*boost::in_edges(taskId, g.g).first, g.g);
+      // Equal shares and a link that moves nothing: the consumer's CPU share
+      // only ever reads its producer's CPU share.
+      if (isFusible(pred) && boost::out_degree(pred, g.g) == 1 &&
+          cpuPageBlkCnts[pred] == cpuPageBlkCnts[taskId] &&
+          dpuPageBlkCnts[pred] == dpuPageBlkCnts[taskId]) {
+        const auto edge =
+            planEdgeXfer(g, sched, pred, sched.offloadRatio[orderPos_[pred]])
+                .front();
+        if (edge.mapPageBlkCnt == 0 && edge.reducePageBlkCnt == 0)
+          fusedHead[taskId] = fusedHead[pred];
+      }
+    }
+    chainSize[fusedHead[taskId]]++;
+  }
+  for (int &head : fusedHead) {
+    if (head >= 0 && chainSize[head] < 2)
+      head = -1;
+  }
+  return fusedHead;
+}
+
+std::vector<int> HeteroComputePool::planDPUChains(
+    const TaskGraph &g, const Schedule &sched,
+    const std::vector<uint32_t> &dpuPageBlkCnts) noexcept {
+  const int taskNum = sched.order.size();
+  // Batched and skew-balanced shares have their own launch layout, a
+  // broadcast producer has to leave its output in MRAM.
+  auto isChainable = [&](const int taskId) {
+    return Operator::dpuChainOPSet.contains(g.g[taskId].op) &&
+           g.g[taskId].elemType == INT32_32ALN &&
+           dpuPageBlkCnts[taskId] > 0 && dpuBatchPageCnt_[taskId] == 0 &&
+           dpuSlot_[taskId].empty() && !isOutputCached_[taskId] &&
+           bcastPageCnt_[taskId] == 0;
+  };
+
+  std::vector<int> chainHead(taskNum, -1);
+  std::vector<int> chainSize(taskNum, 0);
+  for (const int taskId : sched.order) {
+    if (!isChainable(taskId))
+      continue;
+    chainHead[taskId] = taskId;
+    if (boost::in_degree(taskId, g.g) == 1 && bcastPred_[taskId] < 0) {
+      TaskNode pred = boost::source(*boost::in_edges(taskId, g.g).first, g.g);
+      // A reduction only ends a chain, and the link must leave the
+      // producer's DPU share where the consumer reads it.
+      if (isChainable(pred) && boost::out_degree(pred, g.g) == 1 &&
+          !Operator::reductionOPSet.contains(g.g[pred].op) &&
+          dpuPageBlkCnts[pred] == dpuPageBlkCnts[taskId] &&
+          chainSize[chainHead[pred]] < CHAIN_MAX_STAGE_NUM) {
+        const auto edge =
+            planEdgeXfer(g, sched, pred, sched.offloadRatio[orderPos_[pred]])
+                .front();
+        if (edge.mapPageBlkCnt == 0 && edge.reducePageBlkCnt == 0)
+          chainHead[taskId] = chainHead[pred];
+      }
+    }
+    chainSize[chainHead[taskId]]++;
+  }
+  for (int taskId = 0; taskId < taskNum; ++taskId) {
+    int &head = chainHead[taskId];
+    if (head >= 0 && chainSize[head] < 2)
+      head = -1;
+    // Later REDUCEs wait on the launch that produced their pages.
+    if (head >= 0)
+      dpuLauncher_[taskId] = head;
+  }
+  return chainHead;
+}
+
+std::vector<int>
+HeteroComputePool::planCPURegions(const TaskGraph &g, const Schedule &sched,
+                                  const std::vector<int> &fusedHead) const
+    noexcept {
+  const int taskNum = sched.order.size();
+  std::vector<bool> isCPUOnly(taskNum, false);
+  for (int i = 0; i < taskNum; ++i) {
+    const int taskId = sched.order[i];
+    const OperatorTag opTag = g.g[taskId].op;
+    isCPUOnly[taskId] = sched.offloadRatio[i] == 0.0f &&
+                        !isOutputCached_[taskId] &&
+                        (Operator::computeBoundOPSet.contains(opTag) ||
+                         Operator::memoryBoundOPSet.contains(opTag));
+  }
+
+  // Order is topological, a producer is labelled before its consumer. Only
+  // single-producer/single-consumer links are merged, so a chain never has
+  // an outside dependency past its head nor an outside reader before its tail.
+  // Fused links qualify with a DPU share too, they move nothing.
+  std::vector<int> regionHead(taskNum, -1);
+  std::vector<int> regionSize(taskNum, 0);
+  for (const int taskId : sched.order) {
+    if (!isCPUOnly[taskId] && fusedHead[taskId] < 0)
+      continue;
+    regionHead[taskId] = taskId;
+    if (boost::in_degree(taskId, g.g) == 1) {
+      TaskNode pred = boost::source(*boost::in_edges(taskId, g.g).first, g.g);
+      const bool isFusedLink =
+          fusedHead[taskId] >= 0 && fusedHead[taskId] == fusedHead[pred];
+      if (isFusedLink || (isCPUOnly[taskId] && isCPUOnly[pred] &&
+                          boost::out_degree(pred, g.g) == 1))
+        regionHead[taskId] = regionHead[pred];
+    }
+    regionSize[regionHead[taskId]]++;
+  }
+  for (int &head : regionHead) {
+    if (head >= 0 && regionSize[head] < 2)
+      head = -1;
+  }
+  return regionHead;
+}
+
+void HeteroComputePool::execCPURegion(
+    const std::vector<regionOp> &region) const noexcept {
+  // A tile is read from two sources and written once, keep all three in L2.
+  static const size_t tileSize_Byte = [] {
+    long l2Size_Byte = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (l2Size_Byte <= 0)
+      l2Size_Byte = CPU_REGION_L2_FALLBACK_BYTE;
+    // Kernels work on whole chunks, tiles must not split one.
+    return std::max<size_t>(DPU_DMA_BFFR_BYTE, l2Size_Byte / 3 /
+                                                   DPU_DMA_BFFR_BYTE *
+                                                   DPU_DMA_BFFR_BYTE);
+  }();
+  const size_t pageBlkSize = om.getPageBlkSize();
+  size_t regionSpan_Byte = 0;
+  for (const auto &entry : region) {
+    regionSpan_Byte = std::max(regionSpan_Byte,
+                               (size_t)entry.cpuTCB.pageBlkCnt * pageBlkSize);
+  }
+  const size_t tileNum = divceil(regionSpan_Byte, tileSize_Byte);
+
+  // One tile per thread at a time, operators nest serially inside it. The
+  // team size is left to OpenMP, the pool does not pin a CPU thread count.
+#pragma omp parallel for schedule(static)
+  for (size_t tileIdx = 0; tileIdx < tileNum; tileIdx++) {
+    const size_t offset = tileIdx * tileSize_Byte;
+    auto tileOf = [&](const CPU_TCB &cpuTCB) {
+      const size_t span_Byte = (size_t)cpuTCB.pageBlkCnt * pageBlkSize;
+      CPU_TCB tileTCB = cpuTCB;
+      tileTCB.src1PageBase = (char *)cpuTCB.src1PageBase + offset;
+      tileTCB.src2PageBase = (char *)cpuTCB.src2PageBase + offset;
+      tileTCB.dstPageBase = (char *)cpuTCB.dstPageBase + offset;
+      tileTCB.tileSize_Byte = std::min(tileSize_Byte, span_Byte - offset);
+      return tileTCB;
+    };
+    for (size_t k = 0; k < region.size();) {
+      // Fused entries share the span of the head they continue.
+      size_t end = k + 1;
+      while (end < region.size() && region[end].isFused)
+        end++;
+      const size_t span_Byte =
+          (size_t)region[k].cpuTCB.pageBlkCnt * pageBlkSize;
+      if (offset >= span_Byte) {
+        k = end;
+        continue;
+      }
+      if (end - k == 1) {
+        om.execCPU(region[k].op, tileOf(region[k].cpuTCB),
+                   region[k].elemType);
+      } else {
+        std::vector<Operator::ElemwiseStage> stages(end - k);
+        for (size_t j = k; j < end; j++) {
+          om.getElemwiseStage(region[j].op, tileOf(region[j].cpuTCB),
+                              stages[j - k]);
+        }
+        const CPU_TCB headTCB = tileOf(region[k].cpuTCB);
+        Operator::getCPUKernels().elemwiseFusedSpan(
+            (const char *)headTCB.src1PageBase,
+            (char *)tileOf(region[end - 1].cpuTCB).dstPageBase,
+            headTCB.tileSize_Byte, stages);
+      }
+      k = end;
+    }
+  }
+}
+
+void HeteroComputePool::planBroadcasts(
+    const TaskGraph &g, const Schedule &sched,
+    const std::vector<uint32_t> &dpuPageBlkCnts) noexcept {
+  // Only a DPU share reads the region, and a kernel has a single src2.
+  std::vector<uint32_t> wantedPageCnt(sched.order.size(), 0);
+  for (const int taskId : sched.order) {
+    if (dpuPageBlkCnts[taskId] == 0 ||
+        !Operator::bcastOperandOPSet.contains(g.g[taskId].op))
+      continue;
+    auto inEdges = boost::in_edges(taskId, g.g);
+    for (auto ei = inEdges.first; ei != inEdges.second; ++ei) {
+      if (!g.g[*ei].isBroadcast)
+        continue;
+      const int pred = boost::source(*ei, g.g);
+      const TaskProperties &predTp = g.g[pred];
+      const uint32_t pageCnt = om.getBcastPageCnt(
+          g.g[*ei].dataSize_Ratio *
+          om.getOutputSize_MiB(predTp.op, predTp.inputSize_MiB));
+      if (pageCnt == 0)
+        continue;
+      bcastPred_[taskId] = pred;
+      src2WrapPageCnt_[taskId] = pageCnt;
+      wantedPageCnt[pred] = std::max(wantedPageCnt[pred], pageCnt);
+      break;
+    }
+  }
+
+  // Ranges are never reused within a run: a consumer may still wait on its
+  // pages when a later producer broadcasts.
+  uint32_t usedPageCnt = 0;
+  for (const int taskId : sched.order) {
+    const uint32_t pageCnt = wantedPageCnt[taskId];
+    if (pageCnt == 0 || usedPageCnt + pageCnt > NR_BCAST_PAGE)
+      continue;
+    bcastPageIdx_[taskId] = BCAST_PAGE_IDX + usedPageCnt;
+    bcastPageCnt_[taskId] = pageCnt;
+    usedPageCnt += pageCnt;
+  }
+  for (const int taskId : sched.order) {
+    if (const int pred = bcastPred_[taskId];
+        pred >= 0 && bcastPageCnt_[pred] == 0) {
+      bcastPred_[taskId] = -1;
+      src2WrapPageCnt_[taskId] = 0;
+    }
+  }
+}
+
+void HeteroComputePool::planSkewPartitions(
+    const TaskGraph &g, const Schedule &sched,
+    const std::vector<uint32_t> &dpuPageBlkCnts) noexcept {
+  const uint32_t dpuNum = om.getPageBlkSize() / PAGE_SIZE_BYTE;
+  for (const int taskId : sched.order) {
+    if (!Operator::skewAwareOPSet.contains(g.g[taskId].op) ||
+        dpuPageBlkCnts[taskId] == 0 || boost::in_degree(taskId, g.g) != 1)
+      continue;
+    // Moving a page to another DPU is only safe when no DPU-resident copy
+    // in round-robin order is read or left behind.
+    const int pred = boost::source(*boost::in_edges(taskId, g.g).first, g.g);
+    bool isStaged = dpuPageBlkCnts[pred] == 0;
+    auto outEdges = boost::out_edges(taskId, g.g);
+    for (auto ei = outEdges.first; ei != outEdges.second; ++ei) {
+      isStaged = isStaged && dpuPageBlkCnts[boost::target(*ei, g.g)] == 0;
+    }
+    if (!sched.isAlwaysWrittingBack && !isStaged)
+      continue;
+
+    // The map covers every page the MAP in and the REDUCE out may touch.
+    uint32_t slotPageBlkCnt = dpuPageBlkCnts[taskId];
+    for (const auto &edge : planEdgeXfer(g, sched, pred,
+                                         sched.offloadRatio[orderPos_[pred]])) {
+      if (edge.succ == taskId)
+        slotPageBlkCnt = std::max(slotPageBlkCnt, edge.mapPageBlkCnt);
+    }
+    for (const auto &edge : planEdgeXfer(
+             g, sched, taskId, sched.offloadRatio[orderPos_[taskId]])) {
+      slotPageBlkCnt = std::max(slotPageBlkCnt, edge.reducePageBlkCnt);
+    }
+    dpuSlot_[taskId].resize((size_t)slotPageBlkCnt * dpuNum);
+    for (size_t i = 0; i < dpuSlot_[taskId].size(); ++i) {
+      dpuSlot_[taskId][i] = i % dpuNum;
+    }
+  }
+}
+
+void HeteroComputePool::balanceSkewPartition(int taskId, OperatorTag opTag,
+                                             const char *hostBasePtr) noexcept {
+  std::vector<uint32_t> &dpuSlot = dpuSlot_[taskId];
+  std::vector<float> pageCosts(dpuSlot.size());
+  for (size_t i = 0; i < pageCosts.size(); ++i) {
+    pageCosts[i] =
+        om.estimatePageCost(opTag, hostBasePtr + i * PAGE_SIZE_BYTE);
+  }
+  // Same size as planned, descriptors already point into it.
+  const auto balanced = Operator::OperatorBase::balanceDPUSlots(
+      pageCosts, om.getPageBlkSize() / PAGE_SIZE_BYTE);
+  std::copy(balanced.begin(), balanced.end(), dpuSlot.begin());
+}
+
+std::vector<size_t> HeteroComputePool::planDPUBatches(
+    const TaskGraph &g, const Schedule &sched,
+    const std::vector<uint32_t> &dpuPageBlkCnts) noexcept {
+  const size_t taskNum = sched.order.size();
+  std::vector<size_t> queueOrder(taskNum);
+  std::iota(queueOrder.begin(), queueOrder.end(), 0);
+  for (size_t taskId = 0; taskId < taskNum; ++taskId) {
+    auto inEdges = boost::in_edges(taskId, g.g);
+    for (auto ei = inEdges.first; ei != inEdges.second; ++ei) {
+      dpuDependencies_[taskId].push_back(boost::source(*ei, g.g));
+    }
+  }
+
+  // Nodes of one stage (longest path from the sources) never depend on each
+  // other.
+  std::vector<int> stage(taskNum, 0);
+  for (const int taskId : sched.order) {
+    for (const int pred : dpuDependencies_[taskId]) {
+      stage[taskId] = std::max(stage[taskId], stage[pred] + 1);
+    }
+  }
+  std::vector<size_t> stageOrder = queueOrder;
+  std::stable_sort(stageOrder.begin(), stageOrder.end(),
+                   [&](const size_t a, const size_t b) {
+                     return stage[sched.order[a]] < stage[sched.order[b]];
+                   });
+
+  // Greedy packing in queue order, the broadcast region and the CODEC stage
+  // at the MRAM tail stay free. A broadcast src2 cannot join a fused range,
+  // and a reduction would fold its siblings into its partial.
+  std::vector<std::vector<int>> batches;
+  std::map<std::tuple<int, OperatorTag, int>, size_t> openBatch;
+  std::vector<uint32_t> batchPageCnt;
+  for (const size_t i : stageOrder) {
+    const int taskId = sched.order[i];
+    const OperatorTag opTag = g.g[taskId].op;
+    const uint32_t pageCnt = dpuPageBlkCnts[taskId];
+    if (pageCnt == 0 || 3 * pageCnt > BCAST_PAGE_IDX ||
+        bcastPred_[taskId] >= 0 ||
+        Operator::reductionOPSet.contains(opTag) ||
+        !(Operator::computeBoundOPSet.contains(opTag) ||
+          Operator::memoryBoundOPSet.contains(opTag)))
+      continue;
+    // Each element type is its own binary.
+    const auto key =
+        std::make_tuple(stage[taskId], opTag, g.g[taskId].elemType);
+    if (!openBatch.contains(key) ||
+        3 * (batchPageCnt[openBatch[key]] + pageCnt) > BCAST_PAGE_IDX) {
+      openBatch[key] = batches.size();
+      batches.push_back({});
+      batchPageCnt.push_back(0);
+    }
+    batches[openBatch[key]].push_back(taskId);
+    batchPageCnt[openBatch[key]] += pageCnt;
+  }
+
+  bool isBatched = false;
+  for (size_t b = 0; b < batches.size(); ++b) {
+    if (batches[b].size() < 2)
+      continue;
+    isBatched = true;
+    const int launcher = batches[b].back();
+    std::vector<int> deps;
+    uint32_t dpuPageBaseIdx = 0;
+    for (const int member : batches[b]) {
+      dpuLauncher_[member] = launcher;
+      dpuPageBaseIdx_[member] = dpuPageBaseIdx;
+      dpuBatchPageCnt_[member] = batchPageCnt[b];
+      dpuPageBaseIdx += dpuPageBlkCnts[member];
+      deps.insert(deps.end(), dpuDependencies_[member].begin(),
+                  dpuDependencies_[member].end());
+    }
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    dpuDependencies_[launcher] = deps;
+  }
+  // A launcher waits on its whole batch, the queues then have to walk stage
+  // by stage or a member could sit behind work that waits on it.
+  return isBatched ? stageOrder : queueOrder;
+}
+
 std::pair<Task, Task> HeteroComputePool::genXferTask(int taskId, OperatorTag opTag, 
-                                    const CPU_TCB& mapTCB, const CPU_TCB& reduceTCB,
+                                    const std::vector<CPU_TCB>& mapTCBs,
+                                    const std::vector<CPU_TCB>& reduceTCBs,
+                                    double compressRatio,
                                     execType eT) noexcept {
   Task mapTask, reduceTask;
 
@@ -160,21 +547,39 @@ std::pair<Task, Task> HeteroComputePool::genXferTask(int taskId, OperatorTag opT
   mapTask = {true,taskId, []() {}, "MAP"};
   reduceTask = {true,taskId, []() {},  "REDUCE"};
 
-  // If this node is LOGIC_END, no xfer to next(because no succNodes)
-  if (opTag != OperatorTag::LOGIC_END && opTag != OperatorTag::LOGIC_START) {
+  // If this node is LOGIC_END, no xfer to next(because no succNodes).
+  // LOGIC_START only has something to map when a dataset is bound.
+  const bool isStartMappable = opTag == OperatorTag::LOGIC_START &&
+                               dataset != nullptr && dataset->isValid();
+  if (opTag != OperatorTag::LOGIC_END &&
+      (opTag != OperatorTag::LOGIC_START || isStartMappable)) {
     if (eT == execType::DO) {
-      reduceTask.execute = [this,reduceTCB]() {
-        om.execCPU(OperatorTag::REDUCE, reduceTCB);
+      reduceTask.execute = [this,reduceTCBs]() {
+        for (const auto &reduceTCB : reduceTCBs)
+          om.execCPU(OperatorTag::REDUCE, reduceTCB);
       };
-      mapTask.execute = [this,mapTCB]() {
-        om.execCPU(OperatorTag::MAP, mapTCB);
+      mapTask.execute = [this,mapTCBs]() {
+        for (const auto &mapTCB : mapTCBs)
+          om.execCPU(OperatorTag::MAP, mapTCB);
       };
     } else {
-      reduceTask.execute = [this, taskId, pageBlkCnt = reduceTCB.sgInfo.pageBlkCnt]() {
-        const auto perf =
-            (pageBlkCnt == 0)
-                ? perfStats{}
-                : om.deducePerfCPU(OperatorTag::REDUCE, pageBlkCnt);
+      // Each edge descriptor is a separate scatter-gather transfer.
+      auto deduceXfer = [this, compressRatio](OperatorTag xferTag,
+                                              const std::vector<CPU_TCB> &tcbs) {
+        perfStats perf;
+        for (const auto &tcb : tcbs) {
+          const uint32_t pageBlkCnt = tcb.sgInfo.pageBlkCnt;
+          if (pageBlkCnt == 0)
+            continue;
+          perf = perf + (tcb.sgInfo.isPacked
+                             ? om.deducePerfPackedXfer(xferTag, pageBlkCnt,
+                                                       compressRatio)
+                             : om.deducePerfCPU(xferTag, pageBlkCnt));
+        }
+        return perf;
+      };
+      reduceTask.execute = [this, taskId,
+                            perf = deduceXfer(OperatorTag::REDUCE, reduceTCBs)]() {
         {
           // ------------- critical zone --------------
           std::lock_guard<std::mutex> lock(this->mutex_);
@@ -187,11 +592,8 @@ std::pair<Task, Task> HeteroComputePool::genXferTask(int taskId, OperatorTag opT
         // ------------- critical zone --------------
       };
 
-      mapTask.execute = [this, taskId, pageBlkCnt = mapTCB.sgInfo.pageBlkCnt]() {
-        const auto perf = 
-          (pageBlkCnt == 0)
-                              ? perfStats{}
-                              : om.deducePerfCPU(OperatorTag::MAP, pageBlkCnt);
+      mapTask.execute = [this, taskId,
+                         perf = deduceXfer(OperatorTag::MAP, mapTCBs)]() {
         // ------------- critical zone --------------
         {
           std::lock_guard<std::mutex> lock(this->mutex_);
@@ -204,15 +606,77 @@ std::pair<Task, Task> HeteroComputePool::genXferTask(int taskId, OperatorTag opT
         // ------------- critical zone --------------
       };
     }
-    totalTransfer_mb += (reduceTCB.sgInfo.pageBlkCnt * om.pageBlkSize + mapTCB.sgInfo.pageBlkCnt * om.pageBlkSize)
-    /(1<<20);
+    // Packed pages only move their compressed share over the bus, a
+    // broadcast leaves the host once.
+    for (const auto &tcbs : {mapTCBs, reduceTCBs}) {
+      for (const auto &tcb : tcbs) {
+        const double xferRatio = tcb.sgInfo.isPacked ? compressRatio : 1.0f;
+        const size_t unit_Byte =
+            tcb.sgInfo.isBroadcast ? PAGE_SIZE_BYTE : om.getPageBlkSize();
+        totalTransfer_mb +=
+            xferRatio * tcb.sgInfo.pageBlkCnt * unit_Byte / (1 << 20);
+      }
+    }
   }
 
   return {mapTask, reduceTask};
 }
 
+std::vector<HeteroComputePool::edgeXfer>
+HeteroComputePool::planEdgeXfer(const TaskGraph &g, const Schedule &sched,
+                                int taskId,
+                                float offloadRatio) const noexcept {
+  const TaskProperties &tp = g.g[taskId];
+  // Reduction operators only leave their per-DPU partials behind.
+  const double outputSize_MiB = om.getOutputSize_MiB(tp.op, tp.inputSize_MiB);
+  std::vector<edgeXfer> edges;
+
+  auto outEdges = boost::out_edges(taskId, g.g);
+  for (auto ei = outEdges.first; ei != outEdges.second; ++ei) {
+    TaskNode succ = boost::target(*ei, g.g);
+    float succOffloadRatio = sched.offloadRatio[orderPos_[succ]];
+    // Bytes the consumer actually reads from this producer.
+    const double payload_MiB = g.g[*ei].dataSize_Ratio * outputSize_MiB;
+    double mapWork_MiB, reduceWork_MiB;
+    if (sched.isAlwaysWrittingBack) {
+      reduceWork_MiB = offloadRatio * outputSize_MiB;
+      mapWork_MiB = succOffloadRatio * payload_MiB;
+    } else {
+      reduceWork_MiB = std::max(0.0f, offloadRatio - succOffloadRatio) * payload_MiB;
+      mapWork_MiB = std::max(0.0f, succOffloadRatio - offloadRatio) * payload_MiB;
+    }
+    // A broadcast operand is sent whole from the host, so the producer's
+    // DPU share of it comes back first.
+    if (g.g[*ei].isBroadcast && bcastPred_[succ] == taskId) {
+      mapWork_MiB = 0;
+      reduceWork_MiB = std::max(
+          reduceWork_MiB, std::min(payload_MiB, offloadRatio * outputSize_MiB));
+    }
+    // A reduction's DPU share is gathered as per-DPU partials by its own
+    // launch, no output page comes back.
+    if (Operator::reductionOPSet.contains(tp.op))
+      reduceWork_MiB = 0;
+    edges.push_back({succ, om.getNearestPageBlkCnt(mapWork_MiB),
+                     om.getNearestPageBlkCnt(reduceWork_MiB)});
+  }
+  return edges;
+}
+
 void HeteroComputePool::cleanStatus(int taskNum)noexcept{
   dependencies_ = std::vector<std::vector<int>>(taskNum, std::vector<int>());
+  dpuDependencies_ = std::vector<std::vector<int>>(taskNum, std::vector<int>());
+  dpuLauncher_ = std::vector<int>(taskNum);
+  std::iota(dpuLauncher_.begin(), dpuLauncher_.end(), 0);
+  dpuPageBaseIdx_ = std::vector<uint32_t>(taskNum, 0);
+  dpuBatchPageCnt_ = std::vector<uint32_t>(taskNum, 0);
+  bcastPageIdx_ = std::vector<uint32_t>(taskNum, 0);
+  bcastPageCnt_ = std::vector<uint32_t>(taskNum, 0);
+  bcastPred_ = std::vector<int>(taskNum, -1);
+  src2WrapPageCnt_ = std::vector<uint32_t>(taskNum, 0);
+  dpuSlot_ = std::vector<std::vector<uint32_t>>(taskNum);
+  dpuFinishCycles_.clear();
+  dpuReductions_.clear();
+  isOutputCached_ = std::vector<bool>(taskNum, false);
   cpuCompleted_ = std::vector<completeSgn>(taskNum, {false,0.0f});
   dpuCompleted_= std::vector<completeSgn>(taskNum, {false,0.0f});
   mapCompleted_= std::vector<completeSgn>(taskNum, {false,0.0f});
@@ -235,19 +699,267 @@ void HeteroComputePool::cleanStatus(int taskNum)noexcept{
   totalTransfer_mb = 0.0f;
   ct.clear();
 }
+bool HeteroComputePool::bindDataset(const TaskGraph &g,
+                                    const DatasetSource *ds) noexcept {
+  dataset = nullptr;
+  if (ds == nullptr)
+    return true;
+  if (!ds->isValid())
+    return false;
+  // The mapping is read-only and ends at its last page block, every node
+  // reading it has to fit inside.
+  const size_t pageBlkSize = om.getPageBlkSize();
+  for (auto [vi, vEnd] = boost::vertices(g.g); vi != vEnd; ++vi) {
+    bool isDatasetReader = g.g[*vi].op == OperatorTag::LOGIC_START;
+    auto inEdges = boost::in_edges(*vi, g.g);
+    for (auto ei = inEdges.first; ei != inEdges.second; ++ei) {
+      if (g.g[boost::source(*ei, g.g)].op == OperatorTag::LOGIC_START)
+        isDatasetReader = true;
+    }
+    const size_t pageBlkCnt =
+        (g.g[*vi].inputSize_MiB * (1 << 20) + pageBlkSize - 1) / pageBlkSize;
+    if (isDatasetReader && pageBlkCnt > ds->getPageBlkCnt()) {
+      std::cerr << "HCP: " << g.g[*vi].name << " reads " << pageBlkCnt
+                << " page blocks, the dataset only maps "
+                << ds->getPageBlkCnt() << std::endl;
+      return false;
+    }
+  }
+  dataset = ds;
+  return true;
+}
+
+void HeteroComputePool::attachSink(const TaskGraph &g, int taskId,
+                                   const CPU_TCB &cpuTCB,
+                                   uint32_t dpuPageBlkCnt,
+                                   const std::vector<CPU_TCB> &reduceTCBs,
+                                   Task &cpuTask, Task &reduceTask) noexcept {
+  const TaskProperties &tp = g.g[taskId];
+  if (tp.op == OperatorTag::LOGIC_START || tp.op == OperatorTag::LOGIC_END)
+    return;
+  bool isSinkNode = false;
+  auto outEdges = boost::out_edges(taskId, g.g);
+  for (auto ei = outEdges.first; ei != outEdges.second; ++ei) {
+    if (g.g[boost::target(*ei, g.g)].op == OperatorTag::LOGIC_END)
+      isSinkNode = true;
+  }
+  if (!isSinkNode)
+    return;
+
+  // Output file mirrors the pool layout: DPU share first, then CPU share.
+  // The sink stages the pages as soon as they are final, submit returns once
+  // they are copied out, later nodes reuse the pool.
+  const std::string stream = std::to_string(taskId) + "_" + tp.name;
+  const size_t pageBlkSize = om.getPageBlkSize();
+  cpuTask.execute = [this, exec = cpuTask.execute, stream, cpuTCB,
+                     cpuOffset = (off_t)dpuPageBlkCnt * pageBlkSize,
+                     pageBlkSize]() {
+    exec();
+    sink->submit(stream, cpuTCB.dstPageBase,
+                 (size_t)cpuTCB.pageBlkCnt * pageBlkSize, cpuOffset);
+  };
+  // A reduction's DPU share comes back as its combined partial, written
+  // where the share's pages would be.
+  const bool isDPUReduced =
+      dpuPageBlkCnt && Operator::reductionOPSet.contains(tp.op);
+  reduceTask.execute = [this, exec = reduceTask.execute, stream, reduceTCBs,
+                        heapBasePtr = (char *)memPoolPtr[0], pageBlkSize,
+                        isDPUReduced, taskId]() {
+    exec();
+    if (isDPUReduced) {
+      int64_t partial;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        partial = dpuReductions_[taskId];
+      }
+      sink->submit(stream, &partial, sizeof(int64_t), 0);
+    }
+    for (const auto &tcb : reduceTCBs) {
+      sink->submit(stream, tcb.sgInfo.cpuPageBlkBaseAddr,
+                   (size_t)tcb.sgInfo.pageBlkCnt * pageBlkSize,
+                   (char *)tcb.sgInfo.cpuPageBlkBaseAddr - heapBasePtr);
+    }
+  };
+}
+
+std::vector<uint64_t>
+HeteroComputePool::keyOutputs(const TaskGraph &g,
+                              const Schedule &sched) const noexcept {
+  std::vector<uint64_t> keys(sched.order.size(), 0);
+  uint64_t sourceKey = outputCache->getSourceVersion();
+  if (sourceKey == 0 && dataset != nullptr && dataset->isValid()) {
+    sourceKey =
+        OutputCache::hashBytes(dataset->data(), dataset->getFileSize_Byte());
+  }
+  if (sourceKey == 0) // nothing identifies the graph inputs
+    return keys;
+
+  // Same operator on the same bytes and geometry gives the same output.
+  for (const int taskId : sched.order) {
+    const TaskProperties &tp = g.g[taskId];
+    uint64_t key = OutputCache::combine(sourceKey, (uint64_t)tp.op);
+    key = OutputCache::combine(key, tp.inputSize_MiB);
+    key = OutputCache::combine(key, tp.elemType);
+    key = OutputCache::combine(key, om.getPageBlkSize());
+    auto inEdges = boost::in_edges(taskId, g.g);
+    for (auto ei = inEdges.first; ei != inEdges.second; ++ei) {
+      const uint64_t predKey = keys[boost::source(*ei, g.g)];
+      key = predKey == 0 ? 0
+                         : OutputCache::combine(
+                               OutputCache::combine(key, predKey),
+                               (uint64_t)(g.g[*ei].dataSize_Ratio * (1 << 20)));
+      if (key == 0)
+        break;
+    }
+    keys[taskId] = key;
+  }
+  // Only compute nodes hold outputs worth keeping.
+  for (const int taskId : sched.order) {
+    const OperatorTag opTag = g.g[taskId].op;
+    if (!Operator::computeBoundOPSet.contains(opTag) &&
+        !Operator::memoryBoundOPSet.contains(opTag))
+      keys[taskId] = 0;
+  }
+  return keys;
+}
+
+void HeteroComputePool::attachCacheFill(uint64_t key, uint32_t cpuPageBlkCnt,
+                                        uint32_t dpuPageBlkCnt,
+                                        const CPU_TCB &cpuTCB,
+                                        const std::vector<CPU_TCB> &reduceTCBs,
+                                        Task &cpuTask,
+                                        Task &reduceTask) noexcept {
+  // Only outputs fully on the host are kept, a DPU share has to be written
+  // back whole by this node's own REDUCE.
+  uint32_t reducedPageBlkCnt = 0;
+  for (const auto &tcb : reduceTCBs) {
+    reducedPageBlkCnt += tcb.sgInfo.pageBlkCnt;
+  }
+  if (reducedPageBlkCnt != dpuPageBlkCnt)
+    return;
+
+  // Entries mirror the sink layout: DPU share first, then CPU share.
+  const size_t pageBlkSize = om.getPageBlkSize();
+  const size_t size_Byte =
+      ((size_t)cpuPageBlkCnt + dpuPageBlkCnt) * pageBlkSize;
+  if (cpuPageBlkCnt) {
+    cpuTask.execute = [this, exec = cpuTask.execute, key, size_Byte, cpuTCB,
+                       cpuOffset = (size_t)dpuPageBlkCnt * pageBlkSize,
+                       pageBlkSize]() {
+      exec();
+      outputCache->fill(key, size_Byte, cpuOffset, cpuTCB.dstPageBase,
+                        (size_t)cpuTCB.pageBlkCnt * pageBlkSize);
+    };
+  }
+  if (dpuPageBlkCnt) {
+    reduceTask.execute = [this, exec = reduceTask.execute, key, size_Byte,
+                          reduceTCBs, heapBasePtr = (char *)memPoolPtr[0],
+                          pageBlkSize]() {
+      exec();
+      for (const auto &tcb : reduceTCBs) {
+        outputCache->fill(key, size_Byte,
+                          (char *)tcb.sgInfo.cpuPageBlkBaseAddr - heapBasePtr,
+                          tcb.sgInfo.cpuPageBlkBaseAddr,
+                          (size_t)tcb.sgInfo.pageBlkCnt * pageBlkSize);
+      }
+    };
+  }
+}
+
 // TODO:
 // 1. Further capsulate this function to a multi-level modulized style
 // 2. Add coarse-grained schedule specific task parsing.
-void HeteroComputePool::parseGraph(const TaskGraph &g, const Schedule &sched,
+void HeteroComputePool::parseGraph(const TaskGraph &g,
+                                   const Schedule &givenSched,
                                    execType eT) noexcept {
-  int taskNum = sched.order.size();
+  int taskNum = givenSched.order.size();
   cleanStatus(taskNum); 
+  // Schedule ratios are by order position, the graph by task id.
+  orderPos_ = std::vector<size_t>(taskNum);
+  for (int i = 0; i < taskNum; ++i) {
+    orderPos_[givenSched.order[i]] = i;
+  }
   uint32_t pageBlkSize = om.getPageBlkSize();
+
+  // Cached outputs are restored on the host, their nodes run as CPU-only
+  // no-ops and feed DPU consumers through plain MAPs. MIMIC only prices the
+  // schedule, it neither hashes the inputs nor counts hits.
+  Schedule sched = givenSched;
+  std::vector<uint64_t> outputKeys(taskNum, 0);
+  if (outputCache != nullptr && eT == execType::DO) {
+    outputKeys = keyOutputs(g, givenSched);
+  }
+  std::vector<uint32_t> cpuPageBlkCnts(taskNum, 0), dpuPageBlkCnts(taskNum, 0);
   for (size_t i = 0; i < taskNum; ++i) {
+    int taskId = sched.order[i];
+    const TaskProperties &tp = g.g[taskId];
+    uint32_t totalPageBlkCnt =
+        (tp.inputSize_MiB * (1 << 20) + pageBlkSize - 1) / pageBlkSize;
+    if (const uint64_t key = outputKeys[taskId]; key != 0) {
+      if (outputCache->pin(key)) {
+        const uint32_t cpuPageBlkCnt =
+            (1 - sched.offloadRatio[i]) * totalPageBlkCnt;
+        const uint32_t dpuPageBlkCnt = totalPageBlkCnt - cpuPageBlkCnt;
+        outputCache->recordHit(
+            (cpuPageBlkCnt
+                 ? om.deducePerfCPU(tp.op, cpuPageBlkCnt, tp.elemType)
+                 : perfStats{}) +
+            (dpuPageBlkCnt
+                 ? om.deducePerfDPU(tp.op, dpuPageBlkCnt, tp.elemType)
+                 : perfStats{}));
+        isOutputCached_[taskId] = true;
+        sched.offloadRatio[i] = 0.0f;
+      } else {
+        outputCache->recordMiss();
+      }
+    }
+    cpuPageBlkCnts[taskId] = (1 - sched.offloadRatio[i]) * totalPageBlkCnt;
+    dpuPageBlkCnts[taskId] = totalPageBlkCnt - cpuPageBlkCnts[taskId];
+  }
+  planBroadcasts(g, sched, dpuPageBlkCnts);
+  if (eT == execType::DO) {
+    planSkewPartitions(g, sched, dpuPageBlkCnts);
+  }
+  const std::vector<size_t> queueOrder =
+      planDPUBatches(g, sched, dpuPageBlkCnts);
+  const std::vector<int> dpuChainHead =
+      planDPUChains(g, sched, dpuPageBlkCnts);
+  std::vector<uint32_t> dpuChainStageNum(taskNum, 0);
+  for (int taskId = 0; taskId < taskNum; ++taskId) {
+    if (dpuChainHead[taskId] >= 0)
+      dpuChainStageNum[dpuChainHead[taskId]]++;
+  }
+  // A fused chain is priced as one pass at its head in both modes.
+  const std::vector<int> fusedHead =
+      planElemwiseFusion(g, sched, cpuPageBlkCnts, dpuPageBlkCnts);
+  std::vector<uint32_t> fusedStageNum(taskNum, 0);
+  std::vector<bool> isFusedIntoSucc(taskNum, false);
+  for (int taskId = 0; taskId < taskNum; ++taskId) {
+    if (fusedHead[taskId] < 0)
+      continue;
+    fusedStageNum[fusedHead[taskId]]++;
+    if (fusedHead[taskId] != taskId)
+      isFusedIntoSucc[boost::source(*boost::in_edges(taskId, g.g).first,
+                                    g.g)] = true;
+  }
+  // Modeled costs are per operator, only real execution is cache-blocked.
+  const std::vector<int> regionHead =
+      eT == execType::DO ? planCPURegions(g, sched, fusedHead)
+                         : std::vector<int>(taskNum, -1);
+  // Only a region's tail leaves an output behind, its earlier members are
+  // tiled through cache by the head.
+  std::vector<bool> isRegionInner(taskNum, false);
+  for (int taskId = 0; taskId < taskNum; ++taskId) {
+    if (regionHead[taskId] >= 0 && regionHead[taskId] != taskId)
+      isRegionInner[boost::source(*boost::in_edges(taskId, g.g).first,
+                                  g.g)] = true;
+  }
+  std::unordered_map<int, std::shared_ptr<std::vector<regionOp>>> regions;
+  std::unordered_map<int, std::shared_ptr<dpuChain>> dpuChains;
+  for (const size_t i : queueOrder) {
 
     int taskId = sched.order[i];
     const TaskProperties &tp = g.g[taskId];
-    uint32_t totalPageBlkCnt = (tp.inputSize_MiB * (1<<20) + pageBlkSize - 1) /pageBlkSize;
 
     // Looking upward: Dependencies maintain.
     auto inEdges = boost::in_edges(taskId, g.g);
@@ -257,53 +969,152 @@ void HeteroComputePool::parseGraph(const TaskGraph &g, const Schedule &sched,
     }
 
     float offloadRatio = sched.offloadRatio[i];
-    uint32_t cpuPageBlkCnt = (1-offloadRatio) * totalPageBlkCnt;
-    uint32_t dpuPageBlkCnt = totalPageBlkCnt - cpuPageBlkCnt;
-    float omax = 0.0f;
-    float omin = 1.0f;
+    uint32_t cpuPageBlkCnt = cpuPageBlkCnts[taskId];
+    uint32_t dpuPageBlkCnt = dpuPageBlkCnts[taskId];
 
     // Looking downward: Transfer measuring.
-    auto outEdges = boost::out_edges(taskId, g.g);
-    if (outEdges.first != outEdges.second) {
-      for (auto ei = outEdges.first; ei != outEdges.second; ++ei) {
-        TaskNode succ = boost::target(*ei, g.g);
-        float succOffloadRatio = sched.offloadRatio[succ];
-        omax = std::max(omax, succOffloadRatio);
-        omin = std::min(omin, succOffloadRatio);
-      }
-    } else {
-      omax = 0.0f;
-      omin = 0.0f;
+    std::vector<uint32_t> mapPageBlkCnts, mapDPUPageBaseIdxs, reducePageBlkCnts;
+    std::vector<const uint32_t *> mapDPUSlots;
+    std::vector<std::pair<int, OperatorTag>> skewSuccs;
+    for (const auto &edge : planEdgeXfer(g, sched, taskId, offloadRatio)) {
+      mapPageBlkCnts.push_back(edge.mapPageBlkCnt);
+      mapDPUPageBaseIdxs.push_back(dpuPageBaseIdx_[edge.succ]);
+      mapDPUSlots.push_back(dpuSlotOf(edge.succ));
+      reducePageBlkCnts.push_back(edge.reducePageBlkCnt);
+      if (mapDPUSlots.back() != nullptr)
+        skewSuccs.push_back({(int)edge.succ, g.g[edge.succ].op});
     }
 
-    size_t reduceWork_MiB, mapWork_MiB;
+    auto [cpuTCB, dpuTCB, mapTCBs, reduceTCBs] =
+        memPlan(g, taskId, cpuPageBlkCnt, dpuPageBlkCnt, mapPageBlkCnts,
+                mapDPUPageBaseIdxs, mapDPUSlots, reducePageBlkCnts);
+    // Regular page blocks end where the broadcast region, the CODEC stage
+    // and the stat page begin. MIMIC only prices the plan, a real run past
+    // the bound would overwrite them.
+    if (const uint32_t dpuPageEnd = dpuTCB.dstPageIdx + dpuTCB.pageCnt;
+        eT == execType::DO && dpuPageEnd > BCAST_PAGE_IDX) {
+      std::cerr << "HCP: DPU share of " << tp.name << " needs MRAM pages up to "
+                << dpuPageEnd << ", page blocks end at " << BCAST_PAGE_IDX
+                << std::endl;
+      std::abort();
+    }
+    // The codec moves whole page blocks in round-robin order.
+    for (auto &mapTCB : mapTCBs) {
+      if (mapTCB.sgInfo.isBroadcast || mapTCB.sgInfo.dpuSlot != nullptr)
+        continue;
+      mapTCB.sgInfo.isPacked = om.isPackedXferWin(
+          OperatorTag::MAP, mapTCB.sgInfo.pageBlkCnt, tp.xferCompressRatio);
+    }
+    for (auto &reduceTCB : reduceTCBs) {
+      if (reduceTCB.sgInfo.dpuSlot != nullptr)
+        continue;
+      reduceTCB.sgInfo.isPacked = om.isPackedXferWin(
+          OperatorTag::REDUCE, reduceTCB.sgInfo.pageBlkCnt, tp.xferCompressRatio);
+    }
 
-    if (sched.isAlwaysWrittingBack) {
-      reduceWork_MiB = offloadRatio == 0.0f ? 0.0f : tp.inputSize_MiB;
-      mapWork_MiB = omax * tp.inputSize_MiB;
-    } else {
-      if (offloadRatio > omax) {
-        reduceWork_MiB = (offloadRatio - omin) * tp.inputSize_MiB;
-        mapWork_MiB = 0;
-      } else if (offloadRatio > omin && offloadRatio < omax) {
-        reduceWork_MiB = (offloadRatio - omin) * tp.inputSize_MiB;
-        mapWork_MiB = (omax - offloadRatio) * tp.inputSize_MiB;
+    // The launcher runs the fused range of its batch, the other members
+    // only mark their slot.
+    DPU_TCB launchTCB = dpuTCB;
+    if (const uint32_t batchPageCnt = dpuBatchPageCnt_[taskId];
+        batchPageCnt && dpuLauncher_[taskId] == taskId) {
+      launchTCB = {0, batchPageCnt, 2 * batchPageCnt, batchPageCnt};
+    }
+    CPU_TCB computeTCB = cpuTCB;
+    const bool isFusedMember =
+        fusedHead[taskId] >= 0 && fusedHead[taskId] != taskId;
+    if (isOutputCached_[taskId] || isFusedMember) {
+      computeTCB.pageBlkCnt = 0;
+    }
+    auto [cpuTask, dpuTask] =
+        genComputeTask(taskId, tp.op, tp.opType, computeTCB, launchTCB, eT,
+                       fusedStageNum[taskId], dpuChainStageNum[taskId],
+                       tp.elemType);
+    if (dpuLauncher_[taskId] != taskId) {
+      dpuTask.execute = []() {};
+    }
+    // Every member adds its stage before the DPU thread starts, the head
+    // launches them all at once.
+    if (const int head = dpuChainHead[taskId];
+        head >= 0 && eT == execType::DO) {
+      auto &chain = dpuChains[head];
+      if (taskId == head) {
+        chain = std::make_shared<dpuChain>(dpuChain{dpuTCB, {}});
+        dpuTask.execute = [this, chain]() {
+          om.execDPUChain(chain->dpuTCB, chain->stages);
+          if (chain->stages.back().opCode < CHAIN_OP_MAC)
+            return;
+          std::lock_guard<std::mutex> lock(mutex_);
+          dpuReductions_[chain->tailId] =
+              om.getDPUReduction(OperatorTag::ELEW_FUSED);
+        };
+      }
+      chain_stage stage;
+      om.getDPUChainStage(tp.op, dpuTCB, stage);
+      chain->stages.push_back(stage);
+      chain->dpuTCB.dstPageIdx = dpuTCB.dstPageIdx;
+      chain->tailId = taskId;
+    }
+    // The head runs its whole chain, later members only keep the
+    // dependency bookkeeping of their slot.
+    if (const int head = regionHead[taskId]; head >= 0) {
+      auto &region = regions[head];
+      if (taskId == head) {
+        region = std::make_shared<std::vector<regionOp>>();
+        cpuTask.execute = [this, region]() { execCPURegion(*region); };
       } else {
-        reduceWork_MiB = 0;
-        mapWork_MiB = (omax - offloadRatio) * tp.inputSize_MiB;
-      } // offloadRatio < omin
+        cpuTask.execute = []() {};
+      }
+      region->push_back({tp.op, cpuTCB, isFusedMember, tp.elemType});
+    }
+    auto [mapTask, reduceTask] =
+        genXferTask(taskId, tp.op, mapTCBs, reduceTCBs, tp.xferCompressRatio, eT);
+    if (!skewSuccs.empty()) {
+      mapTask.execute = [this, exec = mapTask.execute, skewSuccs,
+                         hostBasePtr = mapBasePtr(g, taskId)]() {
+        for (const auto &[succ, succOp] : skewSuccs)
+          balanceSkewPartition(succ, succOp, hostBasePtr);
+        exec();
+      };
+    }
+    if (eT == execType::DO && dpuPageBlkCnt &&
+        Operator::skewAwareOPSet.contains(tp.op) &&
+        dpuLauncher_[taskId] == taskId) {
+      dpuTask.execute = [this, exec = dpuTask.execute, taskId, opTag = tp.op]() {
+        exec();
+        std::lock_guard<std::mutex> lock(mutex_);
+        dpuFinishCycles_[taskId] = om.getDPUFinishCycles(opTag);
+      };
+    }
+    if (eT == execType::DO && dpuPageBlkCnt &&
+        Operator::reductionOPSet.contains(tp.op) &&
+        dpuLauncher_[taskId] == taskId) {
+      dpuTask.execute = [this, exec = dpuTask.execute, taskId, opTag = tp.op]() {
+        exec();
+        std::lock_guard<std::mutex> lock(mutex_);
+        dpuReductions_[taskId] = om.getDPUReduction(opTag);
+      };
     }
-    
-    uint32_t mapPageBlkCnt = om.getNearestPageBlkCnt(mapWork_MiB);
-    uint32_t reducePageBlkCnt = om.getNearestPageBlkCnt(reduceWork_MiB);
-
 
-    auto [cpuTCB, dpuTCB, mapTCB, reduceTCB] = memPlan(g,i,cpuPageBlkCnt, dpuPageBlkCnt, mapPageBlkCnt, reducePageBlkCnt);
+    // A fused or region intermediate never reaches memory whole, there is
+    // nothing to keep.
+    if (eT == execType::DO && outputKeys[taskId] != 0 &&
+        !isFusedIntoSucc[taskId] && !isRegionInner[taskId]) {
+      const uint64_t key = outputKeys[taskId];
+      if (isOutputCached_[taskId]) {
+        cpuTask.execute = [this, key, cpuTCB, pageBlkSize]() {
+          outputCache->restore(key, cpuTCB.dstPageBase,
+                               (size_t)cpuTCB.pageBlkCnt * pageBlkSize);
+        };
+      } else {
+        attachCacheFill(key, cpuPageBlkCnt, dpuPageBlkCnt, cpuTCB, reduceTCBs,
+                        cpuTask, reduceTask);
+      }
+    }
 
-    auto [cpuTask, dpuTask] = genComputeTask(
-        taskId, tp.op, tp.opType, cpuTCB, dpuTCB, eT);
-    auto [mapTask, reduceTask] =
-        genXferTask(taskId, tp.op, mapTCB, reduceTCB, eT);
+    if (eT == execType::DO && sink != nullptr) {
+      attachSink(g, taskId, cpuTCB, dpuPageBlkCnt, reduceTCBs, cpuTask,
+                 reduceTask);
+    }
 
     cpuQueue_.push(cpuTask);
     dpuQueue_.push(dpuTask);
@@ -326,7 +1137,7 @@ perfStats HeteroComputePool::execWorkload(const TaskGraph &g,
       &HeteroComputePool::processTasks, this, std::ref(dpuQueue_),
       std::ref(dpuCompleted_),
       [this](int taskId) noexcept {
-        return allDependenciesMet(mapCompleted_, dependencies_[taskId],
+        return allDependenciesMet(mapCompleted_, dpuDependencies_[taskId],
                                   dpuLastWakerTime_ms[taskId],
                                   "DPU","MAP");
       },
@@ -335,7 +1146,7 @@ perfStats HeteroComputePool::execWorkload(const TaskGraph &g,
       &HeteroComputePool::processTasks, this, std::ref(reduceQueue_),
       std::ref(reduceCompleted_),
       [this](int taskId) noexcept {
-        return allDependenciesMet(dpuCompleted_, {taskId},
+        return allDependenciesMet(dpuCompleted_, {dpuLauncher_[taskId]},
                                   reduceLastWakerTime_ms[taskId],
                                   "REDUCE","DPU");
       },
@@ -355,9 +1166,14 @@ perfStats HeteroComputePool::execWorkload(const TaskGraph &g,
       &HeteroComputePool::processTasks, this, std::ref(mapQueue_),
       std::ref(mapCompleted_),
       [this](int taskId) noexcept {
+        // A broadcast needs the DPU share of its operand back on the host.
         return allDependenciesMet(cpuCompleted_, {taskId},
                                   mapLastWakerTime_ms[taskId],
-                                  "MAP","CPU");
+                                  "MAP","CPU") &&
+               (bcastPageCnt_[taskId] == 0 ||
+                allDependenciesMet(reduceCompleted_, {taskId},
+                                   mapLastWakerTime_ms[taskId], "MAP",
+                                   "REDUCE"));
       },
       std::ref(mapTimings_));
 
@@ -367,6 +1183,10 @@ perfStats HeteroComputePool::execWorkload(const TaskGraph &g,
   mapThread.join();
   reduceThread.join();
 
+  if (outputCache != nullptr) {
+    outputCache->unpinAll();
+  }
+
   //---------------  result gathering ----------------
   if (eT == execType::DO) {
     ct.tock("HCP");
@@ -411,8 +1231,9 @@ perfStats HeteroComputePool::execWorkload(const TaskGraph &g,
     auto energyMeanSum =
         energyMeans[0].mean +
         energyMeans[1].mean; // This can only count CPU energy cost.
-    return {energyMeanSum + totalDPUTime_Second * 280, timeMean,
-            totalTransfer_mb};
+    return {energyMeanSum + Operator::OperatorBase::deduceDPUEnergy_Joule(
+                                totalDPUTime_Second, om.getActiveDPUNum()),
+            timeMean, totalTransfer_mb};
   } else { // MIMIC
     perfStats result;
     result.timeCost_Second = std::max(cpuMIMICTime_ms, dpuMIMICTime_ms) / 1000;
@@ -428,6 +1249,18 @@ void HeteroComputePool::printTimings() const noexcept {
   printTimingsForType("DPU", dpuTimings_);
   printTimingsForType("MAP", mapTimings_);
   printTimingsForType("REDUCE", reduceTimings_);
+  // The slowest DPU bounds a launch, report how far it trails the mean.
+  for (const auto &[taskId, cycles] : dpuFinishCycles_) {
+    if (cycles.empty())
+      continue;
+    const double meanCycle =
+        std::accumulate(cycles.begin(), cycles.end(), 0.0) / cycles.size();
+    const uint64_t maxCycle = *std::max_element(cycles.begin(), cycles.end());
+    std::cout << "Task " << taskId << " - DPU finish: mean " << meanCycle
+              << " cycles, slowest " << maxCycle << " cycles ("
+              << (meanCycle > 0 ? maxCycle / meanCycle : 1.0) << "x)"
+              << std::endl;
+  }
 }
 void HeteroComputePool::outputTimingsToCSV(
     const std::string &filename) const noexcept {
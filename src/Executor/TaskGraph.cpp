@@ -12,7 +12,7 @@ void TaskGraph::traverse() {
 }
 // -----------MetaPB related functions -----------
 // Generate regression task according to op set and batch size.
-regressionTask TaskGraph::genRegressionTask() {
+regressionTask TaskGraph::genRegressionTask() const {
   regressionTask rt;
   Graph::vertex_iterator vi, vi_end;
   for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
@@ -25,6 +25,14 @@ regressionTask TaskGraph::genRegressionTask() {
   }
   return rt;
 }
+std::set<int> TaskGraph::genElemTypes() const {
+  std::set<int> elemTypes;
+  Graph::vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    elemTypes.insert(g[*vi].elemType);
+  }
+  return elemTypes;
+}
 // Using regression model to predict the performance metrics
 // of a specific schedule, batchSize_MiB.
 perfStats TaskGraph::deduceMetrics(const Schedule &, size_t) { return {}; }
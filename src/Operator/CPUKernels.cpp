@@ -0,0 +1,70 @@
+#include "Operator/CPUKernels.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+namespace MetaPB {
+namespace Operator {
+
+namespace {
+const std::map<CPUISA, std::string> isa2Name = {{CPUISA::SCALAR, "scalar"},
+                                                {CPUISA::AVX2, "avx2"},
+                                                {CPUISA::AVX512, "avx512"}};
+
+CPUISA getWidestCPUISA() noexcept {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return CPUISA::AVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return CPUISA::AVX2;
+  return CPUISA::SCALAR;
+}
+} // namespace
+
+CPUISA getCPUISA() noexcept {
+  static const CPUISA cpuISA = [] {
+    const CPUISA widest = getWidestCPUISA();
+    CPUISA chosen = widest;
+    if (const char *env = std::getenv(CPU_ISA_ENV); env != nullptr) {
+      bool isKnown = false;
+      for (const auto &[isa, name] : isa2Name) {
+        if (name != env)
+          continue;
+        isKnown = true;
+        if (isa <= widest) {
+          chosen = isa;
+        } else {
+          std::cerr << CPU_ISA_ENV << "=" << env
+                    << " is not supported by this CPU" << std::endl;
+        }
+      }
+      if (!isKnown) {
+        std::cerr << CPU_ISA_ENV << "=" << env
+                  << " is not one of scalar, avx2, avx512" << std::endl;
+      }
+    }
+    return chosen;
+  }();
+  return cpuISA;
+}
+
+const std::string &getCPUISAName(const CPUISA isa) noexcept {
+  return isa2Name.at(isa);
+}
+
+const CPUKernelTable &getCPUKernels() noexcept {
+  static const CPUKernelTable &table = []() -> const CPUKernelTable & {
+    switch (getCPUISA()) {
+    case CPUISA::AVX512:
+      return avx512::getCPUKernelTable();
+    case CPUISA::AVX2:
+      return avx2::getCPUKernelTable();
+    default:
+      return scalar::getCPUKernelTable();
+    }
+  }();
+  return table;
+}
+
+} // namespace Operator
+} // namespace MetaPB
@@ -4,16 +4,12 @@ namespace MetaPB {
 namespace Operator {
 
 inline void OperatorAFFINE::execCPU(const CPU_TCB &cpuTCB) const noexcept {
-  int *src1 = (int *)cpuTCB.src1PageBase;
-  int *src2 = (int *)cpuTCB.src2PageBase;
-  int *dst = (int *)cpuTCB.dstPageBase;
-  uint32_t itemNum = cpuTCB.pageBlkCnt * pageBlkSize / sizeof(float);
-
-  omp_set_num_threads(64);
-#pragma omp parallel for
-  for (int i = 0; i < itemNum; i++) {
-    dst[i] = src1[i] * (int)weight + src2[i];
-  }
+  getCPUKernels().elemwiseSpan(
+      ElemwiseKind::AFFINE, elemType, (const char *)cpuTCB.src1PageBase,
+      (const char *)cpuTCB.src2PageBase, (char *)cpuTCB.dstPageBase,
+      getCPUSpan_Byte(cpuTCB),
+      [&](size_t offset) { return getSrc2Offset_Byte(cpuTCB, offset); },
+      weight);
 }
 inline void OperatorAFFINE::execDPU(const DPU_TCB &dpuTCB) const noexcept {
   auto DPU_BINARY = getDPUBinaryPath();
@@ -26,6 +22,7 @@ inline void OperatorAFFINE::execDPU(const DPU_TCB &dpuTCB) const noexcept {
   args.dpuTCB.src2PageIdx = dpuTCB.src2PageIdx;
   args.dpuTCB.dstPageIdx = dpuTCB.dstPageIdx;
   args.dpuTCB.pageCnt = dpuTCB.pageCnt;
+  args.dpuTCB.src2WrapPageCnt = dpuTCB.src2WrapPageCnt;
 
   DPU_ASSERT(dpu_broadcast_to(allDPUs, "DPU_INPUT_ARGUMENTS", 0, &args,
                               sizeof(args), DPU_XFER_DEFAULT));
@@ -2,8 +2,16 @@
 //  1. Re-write model constructing with only interpolation.
 //  2. Re-write model caching/loading related code
 #include "Operator/OperatorBase.hpp"
+#include "Operator/CPUKernels.hpp"
+#include "Operator/dpu/CODEC.h"
+#include "Operator/dpu/PARTIAL.h"
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <numeric>
 
 namespace MetaPB {
 namespace Operator {
@@ -12,11 +20,95 @@ using utils::metricTag;
 using utils::Stats;
 
 std::string OperatorBase::getDPUBinaryPath() const noexcept {
-  std::filesystem::path executablePath =
-      std::filesystem::read_symlink("/proc/self/exe");
-  const string parentPath = executablePath.parent_path().parent_path();
-  const string dpuPath = parentPath + "/dpu_bin/" + get_name();
-  return dpuPath;
+  return getDPUBinaryPath(get_name() + getElemTypeSuffix() + dpuVariant);
+}
+
+std::string
+OperatorBase::getDPUBinaryPath(const std::string &binaryName) const noexcept {
+  return getDPUBinaryDir() + binaryName;
+}
+
+const std::string &OperatorBase::getDPUBinaryDir() noexcept {
+  static const std::string dpuBinDir =
+      std::filesystem::read_symlink("/proc/self/exe")
+          .parent_path()
+          .parent_path()
+          .string() +
+      "/dpu_bin/";
+  return dpuBinDir;
+}
+
+std::vector<uint32_t>
+OperatorBase::balanceDPUSlots(const std::vector<float> &pageCosts,
+                              const uint32_t dpuNum) noexcept {
+  std::vector<uint32_t> dpuSlot(pageCosts.size());
+  for (size_t i = 0; i < dpuSlot.size(); i++)
+    dpuSlot[i] = i % dpuNum;
+  const auto [minCost, maxCost] =
+      std::minmax_element(pageCosts.begin(), pageCosts.end());
+  if (pageCosts.empty() || *minCost == *maxCost)
+    return dpuSlot; // round-robin is already balanced
+
+  std::vector<double> dpuLoad(dpuNum, 0.0);
+  std::vector<uint32_t> pageOrder(dpuNum), dpuOrder(dpuNum);
+  for (size_t blkBase = 0; blkBase + dpuNum <= pageCosts.size();
+       blkBase += dpuNum) {
+    const float *blkCosts = pageCosts.data() + blkBase;
+    std::iota(pageOrder.begin(), pageOrder.end(), 0);
+    std::iota(dpuOrder.begin(), dpuOrder.end(), 0);
+    std::sort(pageOrder.begin(), pageOrder.end(),
+              [&](uint32_t a, uint32_t b) { return blkCosts[a] > blkCosts[b]; });
+    std::sort(dpuOrder.begin(), dpuOrder.end(),
+              [&](uint32_t a, uint32_t b) { return dpuLoad[a] < dpuLoad[b]; });
+    for (uint32_t k = 0; k < dpuNum; k++) {
+      dpuSlot[blkBase + dpuOrder[k]] = pageOrder[k];
+      dpuLoad[dpuOrder[k]] += blkCosts[pageOrder[k]];
+    }
+  }
+  return dpuSlot;
+}
+
+namespace {
+#ifdef METAPB_DPU_EMULATED
+constexpr bool isDPUEmulated = true;
+#else
+constexpr bool isDPUEmulated = false;
+#endif
+
+typedef struct stat_xfer_context {
+  uint64_t *dst;
+} stat_xfer_context;
+
+bool get_stat_block(struct sg_block_info *out, uint32_t dpu_index,
+                    uint32_t block_index, void *args) {
+  if (block_index > 0)
+    return false;
+  out->addr = (uint8_t *)(((stat_xfer_context *)args)->dst + dpu_index);
+  out->length = sizeof(uint64_t);
+  return true;
+}
+} // namespace
+
+void OperatorBase::gatherDPUStat(const uint32_t offset_Byte,
+                                 uint64_t *dst) const noexcept {
+  stat_xfer_context ctx = {dst};
+  get_block_t get_block_info = {
+      .f = &get_stat_block, .args = &ctx, .args_size = sizeof(ctx)};
+  DPU_ASSERT(dpu_push_sg_xfer(allDPUs, DPU_XFER_FROM_DPU, "buffer",
+                              DPU_STAT_PAGE_IDX * PAGE_SIZE_BYTE + offset_Byte,
+                              sizeof(uint64_t), &get_block_info,
+                              DPU_SG_XFER_DEFAULT));
+}
+
+void OperatorBase::recordDPUFinishCycles() const noexcept {
+  dpuFinishCycles.assign(dpuNum, 0);
+  gatherDPUStat(0, dpuFinishCycles.data());
+}
+
+void OperatorBase::recordDPUReduction() const noexcept {
+  std::vector<int64_t> partials(dpuNum, 0);
+  gatherDPUStat(DPU_STAT_PARTIAL_OFFSET_BYTE, (uint64_t *)partials.data());
+  dpuReduction = getCPUKernels().combinePartials(partials.data(), dpuNum);
 }
 
 perfStats OperatorBase::execCPUwithProbe(const CPU_TCB &cpuTCB) noexcept {
@@ -58,7 +150,7 @@ perfStats OperatorBase::execDPUwithProbe(const DPU_TCB &dpuTCB) noexcept {
   auto timeMean =
       std::get<Stats>(report.reportItems[metricTag::TimeConsume_ns].data).mean /
       1e9;
-  auto energyMean = timeMean * DPU_ENERGY_CONSTANT_PER_SEC;
+  auto energyMean = deduceDPUEnergy_Joule(timeMean, dpuNum);
 
   return {energyMean, timeMean};
 }
@@ -85,37 +177,40 @@ void OperatorBase::savePerfSamples(const perfStats src[],
 
 void OperatorBase::loadPerfSamples(perfStats dst[],
                                    const std::string &path) const noexcept {
-  std::ifstream file(path);
-
-  std::string line, word;
-  getline(file, line); // Skip header line
+  // Slurp the file and walk it with strtod, no per-line stream objects.
+  std::ifstream file(path, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+  const char *line = std::strchr(content.c_str(), '\n'); // Skip header line
   int sampleIdx = 0;
-  while (getline(file, line)) {
-    std::istringstream s(line);
-    perfStats stats;
-
-    // Read data size
-    getline(s, word, ','); // pass the datasize part
-
-    // Read time cost
-    getline(s, word, ',');
-    stats.timeCost_Second = std::stod(word);
-
-    getline(s, word, ',');
-    stats.energyCost_Joule = std::stod(word);
-
-    dst[sampleIdx++] = stats;
+  while (line != nullptr && sampleIdx <= PERF_SAMPLE_POINT) {
+    char *cur = nullptr;
+    std::strtod(line + 1, &cur); // pass the datasize part
+    if (cur == line + 1)
+      break;
+    dst[sampleIdx].timeCost_Second = std::strtod(cur + 1, &cur);
+    dst[sampleIdx].energyCost_Joule = std::strtod(cur + 1, &cur);
+    sampleIdx++;
+    line = std::strchr(cur, '\n');
   }
+}
 
-  file.close();
+std::string
+OperatorBase::modelCacheTag(const uint32_t pageUpperBound) const noexcept {
+  float dataSize_MiB =
+      pageUpperBound * (std::size_t)pageBlkSize / (float)(1 << 20);
+  const uint32_t cpuRev = getCPUKernelRevision();
+  return this->get_name() + getElemTypeSuffix() +
+         (cpuRev ? "_cpuRev" + std::to_string(cpuRev) : std::string()) + "_" +
+         getCPUISAName(getCPUISA()) + "_" +
+         std::to_string(dataSize_MiB) + "_MiB_" + std::to_string(dpuNum) +
+         "x" + std::to_string(PAGE_SIZE_BYTE) + "B_" +
+         std::to_string(PERF_SAMPLE_POINT) + "_sample.csv";
 }
 
 bool OperatorBase::loadModelCacheIfExist(
     const uint32_t pageUpperBound) noexcept {
-  float dataSize_MiB = pageUpperBound * (std::size_t)pageBlkSize / (float)(1 << 20);
-  std::string modelTagPostfix =
-      this->get_name() + "_" + std::to_string(dataSize_MiB) + "_MiB_" +
-      std::to_string(PERF_SAMPLE_POINT) + "_sample.csv";
+  std::string modelTagPostfix = modelCacheTag(pageUpperBound);
 
   std::string modelPathPrefix = REGRESSION_MODEL_CACHE_PATH;
 
@@ -129,6 +224,8 @@ bool OperatorBase::loadModelCacheIfExist(
       return false;
     }
     if (!checkIfIsCPUOnly()) {
+      if (!loadDPUVariant(modelPathPrefix + "DPUVariant_" + modelTagPostfix))
+        return false;
       std::string DPUPerfSamplePath =
           modelPathPrefix + "DPUPerfSamples_" + modelTagPostfix;
       std::cout << "loading " << DPUPerfSamplePath << std::endl;
@@ -158,6 +255,10 @@ void OperatorBase::trainModel(const uint32_t pageBlkUpperBound) noexcept {
     void *dst = malloc((size_t)pageBlkUpperBound * pageBlkSize);
     std::cout << (size_t)pageBlkUpperBound << " -- " << pageBlkSize<<std::endl;
 
+    // The DPU curve is probed on the variant it will run.
+    if (!checkIfIsCPUOnly())
+      tuneDPUVariant(pageBlkUpperBound);
+
     CPU_TCB cpuTCB{src1, src2, dst};
     cpuTCB.sgInfo = {src1, 0, 0};
     for (std::uint32_t pageBlkCnt = 0; pageBlkCnt <= pageBlkUpperBound;
@@ -179,9 +280,7 @@ void OperatorBase::trainModel(const uint32_t pageBlkUpperBound) noexcept {
     std::cout << "pageBlkUpperBound = " << pageBlkUpperBound 
               << ", pageBlkSize = " << pageBlkSize
               << ", dataSize upperBound = " << dataSizeUpperbound_MiB<<std::endl;
-    std::string modelTagPostfix =
-        this->get_name() + "_" + std::to_string(dataSizeUpperbound_MiB) +
-        "_MiB_" + std::to_string(PERF_SAMPLE_POINT) + "_sample.csv";
+    std::string modelTagPostfix = modelCacheTag(pageBlkUpperBound);
 
     std::string modelPathPrefix = REGRESSION_MODEL_CACHE_PATH;
     std::string CPUPerfSamplePath =
@@ -196,5 +295,91 @@ void OperatorBase::trainModel(const uint32_t pageBlkUpperBound) noexcept {
   }
 }
 
+// ---------------- DPU kernel variant autotuning -----------------------
+std::vector<std::string> OperatorBase::getDPUVariantsOfSelf() const noexcept {
+  // Variants are built for the int kernels only.
+  if (elemType != INT32_32ALN)
+    return {""};
+  for (const auto &[opTag, opName] : tag2Name)
+    if (opName == get_name())
+      return getDPUVariants(opTag);
+  return {""};
+}
+
+void OperatorBase::saveDPUVariant(const std::string &path,
+                                  const double timeCost_Second) const noexcept {
+  std::ofstream dataFile(path);
+  std::cout << "saving DPU variant file to: " << path << std::endl;
+  dataFile << "variant,timeCost_Second,isAuthoritative\n"
+           << dpuVariant << "," << std::to_string(timeCost_Second) << ","
+           << isDPUVariantAuthoritative;
+}
+
+bool OperatorBase::loadDPUVariant(const std::string &path) noexcept {
+  const std::vector<std::string> variants = getDPUVariantsOfSelf();
+  dpuVariant.clear();
+  isDPUVariantAuthoritative = !isDPUEmulated;
+  if (variants.size() < 2)
+    return true; // nothing to tune, the default is the only build
+  std::cout << "loading " << path << std::endl;
+  std::ifstream file(path);
+  std::string line, variant, timeCost, isAuthoritative;
+  if (!std::getline(file, line) || !std::getline(file, variant, ',') ||
+      !std::getline(file, timeCost, ',') ||
+      !std::getline(file, isAuthoritative))
+    return false;
+  if (std::find(variants.begin(), variants.end(), variant) == variants.end())
+    return false; // built differently since
+  // A pick made on the emulator is tuned again once DPUs are there.
+  if (isAuthoritative != "1" && !isDPUEmulated)
+    return false;
+  dpuVariant = variant;
+  isDPUVariantAuthoritative = isAuthoritative == "1";
+  return true;
+}
+
+void OperatorBase::tuneDPUVariant(const uint32_t pageUpperBound) noexcept {
+  const std::vector<std::string> variants = getDPUVariantsOfSelf();
+  dpuVariant.clear();
+  isDPUVariantAuthoritative = !isDPUEmulated;
+  if (variants.size() < 2)
+    return;
+
+  double bestTime_Second = std::numeric_limits<double>::max();
+  std::string bestVariant;
+  for (const std::string &variant : variants) {
+    dpuVariant = variant;
+    // Summed over sizes, so no single launch size decides alone.
+    double time_Second = 0.0;
+    for (uint32_t point = 1; point <= DPU_VARIANT_TUNE_POINT; point++) {
+      const uint32_t pageCnt =
+          std::max(1u, pageUpperBound * point / DPU_VARIANT_TUNE_POINT);
+      const DPU_TCB dpuTCB{pageCnt, 2 * pageCnt, 3 * pageCnt, pageCnt};
+      for (int rep = 0; rep < PREPROBE_WARMUP_REP; rep++)
+        execDPU(dpuTCB);
+      const auto start = std::chrono::steady_clock::now();
+      for (int rep = 0; rep < PROBE_REP; rep++)
+        execDPU(dpuTCB);
+      time_Second += std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count() /
+                     PROBE_REP;
+    }
+    std::cout << get_name() << (variant.empty() ? " default" : variant)
+              << " variant takes " << time_Second << " s" << std::endl;
+    if (time_Second < bestTime_Second) {
+      bestTime_Second = time_Second;
+      bestVariant = variant;
+    }
+  }
+  dpuVariant = bestVariant;
+  if (!isDPUVariantAuthoritative)
+    std::cout << "DPUs are emulated, the " << get_name()
+              << " variant pick is not authoritative" << std::endl;
+  saveDPUVariant(std::string(REGRESSION_MODEL_CACHE_PATH) + "DPUVariant_" +
+                     modelCacheTag(pageUpperBound),
+                 bestTime_Second);
+}
+
 } // namespace Operator
 } // namespace MetaPB
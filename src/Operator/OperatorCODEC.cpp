@@ -0,0 +1,44 @@
+#include "Operator/OperatorCODEC.hpp"
+
+namespace MetaPB {
+namespace Operator {
+
+inline void OperatorCODEC::execCPU(const CPU_TCB &cpuTCB) const noexcept {
+  for (uint32_t roundBase = 0; roundBase < cpuTCB.pageBlkCnt;
+       roundBase += CODEC_ROUND_PAGE) {
+    const uint32_t pageCnt =
+        std::min<uint32_t>(CODEC_ROUND_PAGE, cpuTCB.pageBlkCnt - roundBase);
+    codec.packRound(cpuTCB.src1PageBase, roundBase, pageCnt);
+  }
+}
+
+inline void OperatorCODEC::execDPU(const DPU_TCB &dpuTCB) const noexcept {
+  auto DPU_BINARY = getDPUBinaryPath();
+  DPU_ASSERT(dpu_load(allDPUs, DPU_BINARY.c_str(), NULL));
+
+  // Worst case stage: every page kept raw.
+  codec_header headers[CODEC_ROUND_PAGE];
+  for (uint32_t page = 0; page < CODEC_ROUND_PAGE; page++) {
+    headers[page] = {0, 32, page * PAGE_SIZE_BYTE, 0};
+  }
+  DPU_ASSERT(dpu_broadcast_to(allDPUs, "buffer",
+                              CODEC_STAGE_PAGE_IDX * PAGE_SIZE_BYTE, headers,
+                              sizeof(headers), DPU_XFER_DEFAULT));
+
+  codec_args args;
+  args.dpuTCB.src1PageIdx = CODEC_STAGE_PAGE_IDX;
+  args.dpuTCB.src2PageIdx = 0;
+  for (uint32_t roundBase = 0; roundBase < dpuTCB.pageCnt;
+       roundBase += CODEC_ROUND_PAGE) {
+    args.dpuTCB.dstPageIdx = dpuTCB.dstPageIdx + roundBase;
+    args.dpuTCB.pageCnt =
+        std::min<uint32_t>(CODEC_ROUND_PAGE, dpuTCB.pageCnt - roundBase);
+    DPU_ASSERT(dpu_broadcast_to(allDPUs, "DPU_INPUT_ARGUMENTS", 0, &args,
+                                sizeof(args), DPU_XFER_DEFAULT));
+    DPU_ASSERT(dpu_launch(allDPUs, DPU_SYNCHRONOUS));
+  }
+  return;
+}
+
+} // namespace Operator
+} // namespace MetaPB
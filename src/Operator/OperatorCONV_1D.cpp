@@ -5,30 +5,26 @@ namespace Operator {
 inline void OperatorCONV_1D::execCPU(const CPU_TCB &cpuTCB) const noexcept {
   char *src = (char *)cpuTCB.src1PageBase;
   char *dst = (char *)cpuTCB.dstPageBase;
-  size_t maxOffset = cpuTCB.pageBlkCnt * pageBlkSize;
-  uint32_t itemNum = cpuTCB.pageBlkCnt * pageBlkSize / sizeof(float);
-  uint32_t pageItemNum = DPU_DMA_BFFR_BYTE / sizeof(float);
+  size_t maxOffset = getCPUSpan_Byte(cpuTCB);
+  const int pageItemNum = DPU_DMA_BFFR_BYTE / sizeof(float);
 
-  size_t padding = (kernelSize - 1) / 2;
+  // Taps truncate to int once, the kernel size picks its specialisation.
+  int taps[8];
+  for (int j = 0; j < kernelSize; ++j) {
+    taps[j] = (int)gaussianKernel[j];
+  }
+  const conv1DChunkFn convChunk = getCPUKernels().selectConv1DChunk(kernelSize);
 
   omp_set_num_threads(64);
   // Page-wised equal padded conv
 #pragma omp parallel for
   for (size_t offset = 0; offset < maxOffset; offset += DPU_DMA_BFFR_BYTE) {
-    int *mySrc = (int *)(src + offset);
+    const int *mySrc = (const int *)(src + offset);
     int *myDst = (int *)(dst + offset);
-    for (size_t i = 0; i < pageItemNum; ++i) {
-      int sum = 0;
-      for (size_t j = 0; j < kernelSize; ++j) {
-        // Compute the input index, considering padding
-        int inputIndex = i - padding + j;
-        // Check if the input index is within bounds
-        if (inputIndex >= 0 && inputIndex < pageItemNum) {
-          sum += mySrc[inputIndex] * (int)gaussianKernel[j];
-        }
-      }
-      myDst[i] = sum;
-    }
+    if (convChunk != nullptr)
+      convChunk(mySrc, myDst, taps, pageItemNum);
+    else
+      conv1DChunkGeneric(mySrc, myDst, taps, kernelSize, pageItemNum);
   }
 }
 
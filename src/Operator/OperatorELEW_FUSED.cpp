@@ -0,0 +1,57 @@
+#include "Operator/OperatorELEW_FUSED.hpp"
+#include <algorithm>
+
+namespace MetaPB {
+namespace Operator {
+
+inline void OperatorELEW_FUSED::execCPU(const CPU_TCB &cpuTCB) const noexcept {
+  auto src2Offset = [&](size_t offset) {
+    return getSrc2Offset_Byte(cpuTCB, offset);
+  };
+  const char *src2 = (const char *)cpuTCB.src2PageBase;
+  const std::vector<ElemwiseStage> stages = {
+      {ElemwiseKind::AFFINE, (int)weight, src2, src2Offset},
+      {ElemwiseKind::ADD, 0, src2, src2Offset},
+      {ElemwiseKind::PROD, 0, src2, src2Offset}};
+  getCPUKernels().elemwiseFusedSpan((const char *)cpuTCB.src1PageBase,
+                                    (char *)cpuTCB.dstPageBase,
+                                    getCPUSpan_Byte(cpuTCB), stages);
+}
+
+inline void OperatorELEW_FUSED::execDPU(const DPU_TCB &dpuTCB) const noexcept {
+  const chain_stage stage = {0, dpuTCB.src2PageIdx, dpuTCB.src2WrapPageCnt,
+                             (int)weight};
+  std::vector<chain_stage> stages(ELEW_FUSED_MODEL_STAGE_NUM, stage);
+  stages[0].opCode = CHAIN_OP_AFFINE;
+  stages[1].opCode = CHAIN_OP_ADD;
+  stages[2].opCode = CHAIN_OP_PROD;
+  execDPUChain(dpuTCB, stages);
+}
+
+void OperatorELEW_FUSED::execDPUChain(
+    const DPU_TCB &dpuTCB,
+    const std::vector<chain_stage> &stages) const noexcept {
+  if (stages.size() > CHAIN_MAX_STAGE_NUM) {
+    std::cerr << "DPU chain of " << stages.size() << " stages exceeds "
+              << CHAIN_MAX_STAGE_NUM << std::endl;
+    return;
+  }
+  auto DPU_BINARY = getDPUBinaryPath();
+  DPU_ASSERT(dpu_load(allDPUs, DPU_BINARY.c_str(), NULL));
+
+  chain_args args;
+  args.src1PageIdx = dpuTCB.src1PageIdx;
+  args.dstPageIdx = dpuTCB.dstPageIdx;
+  args.pageCnt = dpuTCB.pageCnt;
+  args.stageNum = stages.size();
+  std::copy(stages.begin(), stages.end(), args.stages);
+
+  DPU_ASSERT(dpu_broadcast_to(allDPUs, "DPU_INPUT_ARGUMENTS", 0, &args,
+                              sizeof(args), DPU_XFER_DEFAULT));
+  DPU_ASSERT(dpu_launch(allDPUs, DPU_SYNCHRONOUS));
+  if (!stages.empty() && stages.back().opCode >= CHAIN_OP_MAC)
+    recordDPUReduction();
+}
+
+} // namespace Operator
+} // namespace MetaPB
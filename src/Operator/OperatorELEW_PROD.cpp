@@ -4,16 +4,11 @@ namespace MetaPB {
 namespace Operator {
 
 inline void OperatorELEW_PROD::execCPU(const CPU_TCB &cpuTCB) const noexcept {
-  int *src1 = (int *)cpuTCB.src1PageBase;
-  int *src2 = (int *)cpuTCB.src2PageBase;
-  int *dst = (int *)cpuTCB.dstPageBase;
-  uint32_t itemNum = cpuTCB.pageBlkCnt * pageBlkSize / sizeof(float);
-
-  omp_set_num_threads(64);
-#pragma omp parallel for
-  for (int i = 0; i < itemNum; i++) {
-    dst[i] = src1[i] * src2[i];
-  }
+  getCPUKernels().elemwiseSpan(
+      ElemwiseKind::PROD, elemType, (const char *)cpuTCB.src1PageBase,
+      (const char *)cpuTCB.src2PageBase, (char *)cpuTCB.dstPageBase,
+      getCPUSpan_Byte(cpuTCB),
+      [&](size_t offset) { return getSrc2Offset_Byte(cpuTCB, offset); }, 0);
 }
 
 inline void OperatorELEW_PROD::execDPU(const DPU_TCB &dpuTCB) const noexcept {
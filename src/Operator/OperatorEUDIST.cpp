@@ -11,21 +11,18 @@ inline void OperatorEUDIST::execCPU(const CPU_TCB &cpuTCB) const noexcept {
   char *src1 = (char *)cpuTCB.src1PageBase;
   char *src2 = (char *)cpuTCB.src2PageBase;
   char *dst = (char *)cpuTCB.dstPageBase;
-  size_t maxOffset = cpuTCB.pageBlkCnt * pageBlkSize;
-  uint32_t itemNum = cpuTCB.pageBlkCnt * pageBlkSize / sizeof(float);
+  size_t maxOffset = getCPUSpan_Byte(cpuTCB);
+  uint32_t itemNum = maxOffset / sizeof(float);
   uint32_t pageItemNum = DPU_DMA_BFFR_BYTE / sizeof(float);
 
+  const auto eudistChunk = getCPUKernels().eudistChunk;
   omp_set_num_threads(64);
 #pragma omp parallel for
   for (size_t offset = 0; offset < maxOffset; offset += DPU_DMA_BFFR_BYTE) {
     int *mySrc1 = (int *)(src1 + offset);
-    int *mySrc2 = (int *)(src2 + offset);
+    int *mySrc2 = (int *)(src2 + getSrc2Offset_Byte(cpuTCB, offset));
     int *myDst = (int *)(dst + offset);
-    myDst[0] = 0;
-    for (int i = 0; i < pageItemNum; i++) {
-      // ignoring sqrt because DPU doesn't have hardware sqrt
-      myDst[0] += (mySrc2[i] - mySrc1[i]) * (mySrc2[i] - mySrc1[i]);
-    }
+    myDst[0] = eudistChunk(mySrc1, mySrc2, pageItemNum);
   }
 }
 inline void OperatorEUDIST::execDPU(const DPU_TCB &dpuTCB) const noexcept {
@@ -37,6 +34,7 @@ inline void OperatorEUDIST::execDPU(const DPU_TCB &dpuTCB) const noexcept {
   DPU_ASSERT(dpu_broadcast_to(allDPUs, "dpuTCB", 0, &args, sizeof(args),
                               DPU_XFER_DEFAULT));
   DPU_ASSERT(dpu_launch(allDPUs, DPU_SYNCHRONOUS));
+  recordDPUReduction();
   return;
 }
 
@@ -5,26 +5,18 @@ namespace Operator {
 inline void OperatorFILTER::execCPU(const CPU_TCB &cpuTCB) const noexcept {
   char *src = (char *)cpuTCB.src1PageBase;
   char *dst = (char *)cpuTCB.dstPageBase;
-  size_t maxOffset = cpuTCB.pageBlkCnt * pageBlkSize;
-  uint32_t itemNum = cpuTCB.pageBlkCnt * pageBlkSize / sizeof(float);
-  uint32_t pageItemNum = DPU_DMA_BFFR_BYTE / sizeof(float);
-  size_t padding = (kernelSize - 1) / 2;
+  size_t maxOffset = getCPUSpan_Byte(cpuTCB);
+  const int pageItemNum = DPU_DMA_BFFR_BYTE / sizeof(float);
+
+  const auto filterChunk = getCPUKernels().filterChunk;
 
-  // Perform convolution
   omp_set_num_threads(64);
+  // Window stays inside its chunk, as on the DPU.
 #pragma omp parallel for
   for (size_t offset = 0; offset < maxOffset; offset += DPU_DMA_BFFR_BYTE) {
-    int *mySrc = (int *)(src + offset);
+    const int *mySrc = (const int *)(src + offset);
     int *myDst = (int *)(dst + offset);
-
-    for (size_t i = 0; i < pageItemNum; ++i) {
-      int sum = 0;
-      for (size_t j = 0; j < kernelSize; ++j) {
-        if (i + j < itemNum)
-          sum += mySrc[i + j] / kernelSize;
-      }
-      myDst[i] = sum / kernelSize;
-    }
+    filterChunk(mySrc, myDst, pageItemNum);
   }
 }
 
@@ -6,21 +6,30 @@ namespace Operator {
 inline void OperatorLOOKUP::execCPU(const CPU_TCB &cpuTCB) const noexcept {
   char *src = (char *)cpuTCB.src1PageBase;
   char *dst = (char *)cpuTCB.dstPageBase;
-  size_t maxOffset = cpuTCB.pageBlkCnt * pageBlkSize;
-  uint32_t itemNum = cpuTCB.pageBlkCnt * pageBlkSize / sizeof(float);
+  size_t maxOffset = getCPUSpan_Byte(cpuTCB);
+  uint32_t itemNum = maxOffset / sizeof(float);
   uint32_t pageItemNum = DPU_DMA_BFFR_BYTE / sizeof(float);
+  const auto countChunk = getCPUKernels().countChunk;
 
 #pragma omp parallel for
   for (size_t offset = 0; offset < maxOffset; offset += DPU_DMA_BFFR_BYTE) {
-    int *mySrc = (int *)(src + offset);
+    const int *mySrc = (const int *)(src + offset);
     int *myDst = (int *)(dst + offset);
-    myDst[0] = 0;
-    for (int i = 0; i < pageItemNum; i++) {
-      if (mySrc[i] == (int)this->target)
-        myDst[0]++;
-    }
+    myDst[0] = countChunk(mySrc, (int)this->target, pageItemNum);
   }
 }
+inline float
+OperatorLOOKUP::estimatePageCost(const void *page) const noexcept {
+  const int *items = (const int *)page;
+  const uint32_t pageItemNum = PAGE_SIZE_BYTE / sizeof(int);
+  uint32_t hitNum = 0;
+  for (uint32_t i = 0; i < pageItemNum; i += LOOKUP_COST_SAMPLE_STRIDE) {
+    hitNum += items[i] == (int)this->target;
+  }
+  return 1.0f + LOOKUP_HIT_COST * hitNum * LOOKUP_COST_SAMPLE_STRIDE /
+                    pageItemNum;
+}
+
 inline void OperatorLOOKUP::execDPU(const DPU_TCB &dpuTCB) const noexcept {
   auto DPU_BINARY = getDPUBinaryPath();
   DPU_ASSERT(dpu_load(allDPUs, DPU_BINARY.c_str(), NULL));
@@ -37,6 +46,8 @@ inline void OperatorLOOKUP::execDPU(const DPU_TCB &dpuTCB) const noexcept {
                               sizeof(args), DPU_XFER_DEFAULT));
 
   DPU_ASSERT(dpu_launch(allDPUs, DPU_SYNCHRONOUS));
+  recordDPUReduction();
+  recordDPUFinishCycles();
   return;
 }
 
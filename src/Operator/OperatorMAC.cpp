@@ -12,20 +12,18 @@ inline void OperatorMAC::execCPU(const CPU_TCB &cpuTCB) const noexcept {
   char *src1 = (char *)cpuTCB.src1PageBase;
   char *src2 = (char *)cpuTCB.src2PageBase;
   char *dst = (char *)cpuTCB.dstPageBase;
-  size_t maxOffset = cpuTCB.pageBlkCnt * pageBlkSize;
-  uint32_t itemNum = cpuTCB.pageBlkCnt * pageBlkSize / sizeof(float);
+  size_t maxOffset = getCPUSpan_Byte(cpuTCB);
+  uint32_t itemNum = maxOffset / sizeof(float);
   uint32_t pageItemNum = DPU_DMA_BFFR_BYTE / sizeof(float);
 
+  const auto macChunk = getCPUKernels().macChunk;
   omp_set_num_threads(64);
 #pragma omp parallel for
   for (size_t offset = 0; offset < maxOffset; offset += DPU_DMA_BFFR_BYTE) {
     int *mySrc1 = (int *)(src1 + offset);
-    int *mySrc2 = (int *)(src2 + offset);
+    int *mySrc2 = (int *)(src2 + getSrc2Offset_Byte(cpuTCB, offset));
     int *myDst = (int *)(dst + offset);
-    myDst[0] = 0;
-    for (int i = 0; i < pageItemNum; i++) {
-      myDst[0] += mySrc1[i] * mySrc2[i];
-    }
+    myDst[0] = macChunk(mySrc1, mySrc2, pageItemNum);
   }
 }
 
@@ -39,9 +37,11 @@ inline void OperatorMAC::execDPU(const DPU_TCB &dpuTCB) const noexcept {
   args.dpuTCB.src2PageIdx = dpuTCB.src2PageIdx;
   args.dpuTCB.dstPageIdx = dpuTCB.dstPageIdx;
   args.dpuTCB.pageCnt = dpuTCB.pageCnt;
+  args.dpuTCB.src2WrapPageCnt = dpuTCB.src2WrapPageCnt;
   DPU_ASSERT(dpu_broadcast_to(allDPUs, "DPU_INPUT_ARGUMENTS", 0, &args,
                               sizeof(args), DPU_XFER_DEFAULT));
   DPU_ASSERT(dpu_launch(allDPUs, DPU_SYNCHRONOUS));
+  recordDPUReduction();
   return;
 }
 
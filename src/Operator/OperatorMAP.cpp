@@ -4,13 +4,28 @@ namespace MetaPB {
 namespace Operator {
 
 inline void OperatorMAP::execCPU(const CPU_TCB &cpuTCB) const noexcept {
+  if (cpuTCB.sgInfo.isPacked) {
+    codec.scatter(getDPUBinaryPath("CODEC"), cpuTCB.sgInfo.cpuPageBlkBaseAddr,
+                  cpuTCB.sgInfo.dpuPageBaseIdx, cpuTCB.sgInfo.pageBlkCnt);
+    return;
+  }
   auto DPU_BINARY = getDPUBinaryPath();
   DPU_ASSERT(dpu_load(allDPUs, DPU_BINARY.c_str(), NULL));
 
+  if (cpuTCB.sgInfo.isBroadcast) {
+    DPU_ASSERT(dpu_broadcast_to(
+        allDPUs, "buffer", cpuTCB.sgInfo.dpuPageBaseIdx * PAGE_SIZE_BYTE,
+        cpuTCB.sgInfo.cpuPageBlkBaseAddr,
+        cpuTCB.sgInfo.pageBlkCnt * PAGE_SIZE_BYTE, DPU_XFER_DEFAULT));
+    return;
+  }
+
   sg_xfer_context sgInfo;
   sgInfo.cpuPageBlkBaseAddr = cpuTCB.sgInfo.cpuPageBlkBaseAddr;
   sgInfo.dpuPageBaseIdx = cpuTCB.sgInfo.dpuPageBaseIdx;
   sgInfo.pageBlkCnt = cpuTCB.sgInfo.pageBlkCnt;
+  sgInfo.dpuNum = dpuNum;
+  sgInfo.dpuSlot = cpuTCB.sgInfo.dpuSlot;
 
   uint32_t dpuPageBaseIdx = sgInfo.dpuPageBaseIdx;
   uint32_t pageBlkCnt = sgInfo.pageBlkCnt;
@@ -4,6 +4,12 @@ namespace MetaPB {
 namespace Operator {
 
 inline void OperatorREDUCE::execCPU(const CPU_TCB &cpuTCB) const noexcept {
+  if (cpuTCB.sgInfo.isPacked) {
+    codec.gather(getDPUBinaryPath("CODEC_PACK"),
+                 cpuTCB.sgInfo.cpuPageBlkBaseAddr, cpuTCB.sgInfo.dpuPageBaseIdx,
+                 cpuTCB.sgInfo.pageBlkCnt);
+    return;
+  }
   auto DPU_BINARY = getDPUBinaryPath();
   DPU_ASSERT(dpu_load(allDPUs, DPU_BINARY.c_str(), NULL));
   
@@ -11,6 +17,8 @@ inline void OperatorREDUCE::execCPU(const CPU_TCB &cpuTCB) const noexcept {
   sgInfo.cpuPageBlkBaseAddr = cpuTCB.sgInfo.cpuPageBlkBaseAddr;
   sgInfo.dpuPageBaseIdx = cpuTCB.sgInfo.dpuPageBaseIdx;
   sgInfo.pageBlkCnt = cpuTCB.sgInfo.pageBlkCnt;
+  sgInfo.dpuNum = dpuNum;
+  sgInfo.dpuSlot = cpuTCB.sgInfo.dpuSlot;
 
   uint32_t dpuPageBaseIdx = sgInfo.dpuPageBaseIdx;
   uint32_t pageBlkCnt = sgInfo.pageBlkCnt;
@@ -0,0 +1,201 @@
+#include "Operator/XferCodec.hpp"
+#include <algorithm>
+#include <omp.h>
+
+namespace MetaPB {
+namespace Operator {
+
+void XferCodec::reserve(const uint32_t pageCnt) noexcept {
+  size_t headerNum = (size_t)dpuNum * CODEC_ROUND_PAGE;
+  if (headers.size() < headerNum)
+    headers.resize(headerNum);
+  size_t slotItemNum = (size_t)pageCnt * dpuNum * CODEC_ITEM_PER_PAGE;
+  if (slots.size() < slotItemNum)
+    slots.resize(slotItemNum);
+}
+
+void XferCodec::layoutRound(const uint32_t pageCnt) noexcept {
+#pragma omp parallel for
+  for (uint32_t dpu = 0; dpu < dpuNum; dpu++) {
+    uint32_t offset = 0;
+    for (uint32_t page = 0; page < pageCnt; page++) {
+      header(page, dpu).offset = offset;
+      offset += codec_page_byte(header(page, dpu).bitWidth);
+    }
+  }
+}
+
+size_t XferCodec::maxPayloadByte(const uint32_t pageCnt) const noexcept {
+  size_t maxByte = 0;
+  for (uint32_t dpu = 0; dpu < dpuNum; dpu++) {
+    const codec_header &last =
+        headers[(size_t)dpu * CODEC_ROUND_PAGE + pageCnt - 1];
+    maxByte = std::max(maxByte,
+                       (size_t)last.offset + codec_page_byte(last.bitWidth));
+  }
+  return maxByte;
+}
+
+void XferCodec::packRound(const void *cpuPageBlkBaseAddr,
+                          const uint32_t roundBase,
+                          const uint32_t pageCnt) noexcept {
+  reserve(pageCnt);
+#pragma omp parallel for collapse(2)
+  for (uint32_t page = 0; page < pageCnt; page++) {
+    for (uint32_t dpu = 0; dpu < dpuNum; dpu++) {
+      const int32_t *src =
+          (const int32_t *)((const uint8_t *)cpuPageBlkBaseAddr +
+                            PAGE_SIZE_BYTE *
+                                ((size_t)(roundBase + page) * dpuNum + dpu));
+      int32_t minVal = src[0];
+      int32_t maxVal = src[0];
+      for (uint32_t i = 1; i < CODEC_ITEM_PER_PAGE; i++) {
+        minVal = std::min(minVal, src[i]);
+        maxVal = std::max(maxVal, src[i]);
+      }
+      codec_header &hdr = header(page, dpu);
+      hdr.base = minVal;
+      hdr.bitWidth = codec_bit_width((uint32_t)maxVal - (uint32_t)minVal);
+      codec_pack(src, slot(page, dpu), hdr.base, hdr.bitWidth,
+                 CODEC_ITEM_PER_PAGE);
+    }
+  }
+  layoutRound(pageCnt);
+}
+
+void XferCodec::unpackRound(void *cpuPageBlkBaseAddr, const uint32_t roundBase,
+                            const uint32_t pageCnt) noexcept {
+#pragma omp parallel for collapse(2)
+  for (uint32_t page = 0; page < pageCnt; page++) {
+    for (uint32_t dpu = 0; dpu < dpuNum; dpu++) {
+      int32_t *dst =
+          (int32_t *)((uint8_t *)cpuPageBlkBaseAddr +
+                      PAGE_SIZE_BYTE *
+                          ((size_t)(roundBase + page) * dpuNum + dpu));
+      const codec_header &hdr = header(page, dpu);
+      codec_unpack(slot(page, dpu), dst, hdr.base, hdr.bitWidth,
+                   CODEC_ITEM_PER_PAGE);
+    }
+  }
+}
+
+// Block 0 is the header table of this DPU, then one block per packed page.
+bool XferCodec::get_packed_block(struct sg_block_info *out,
+                                 uint32_t dpu_index, uint32_t block_index,
+                                 void *args) {
+  codec_sg_context *ctx = (codec_sg_context *)args;
+  if (block_index > ctx->pageCnt) {
+    return false;
+  }
+  if (block_index == 0) {
+    out->addr = (uint8_t *)&ctx->codec->header(0, dpu_index);
+    out->length = ctx->pageCnt * CODEC_HEADER_BYTE;
+    return true;
+  }
+  const uint32_t page = block_index - 1;
+  out->addr = (uint8_t *)ctx->codec->slot(page, dpu_index);
+  out->length = codec_page_byte(ctx->codec->header(page, dpu_index).bitWidth);
+  return true;
+}
+
+bool XferCodec::get_header_block(struct sg_block_info *out,
+                                 uint32_t dpu_index, uint32_t block_index,
+                                 void *args) {
+  codec_sg_context *ctx = (codec_sg_context *)args;
+  if (block_index > 0) {
+    return false;
+  }
+  out->addr = (uint8_t *)&ctx->codec->header(0, dpu_index);
+  out->length = ctx->pageCnt * CODEC_HEADER_BYTE;
+  return true;
+}
+
+bool XferCodec::get_payload_block(struct sg_block_info *out,
+                                  uint32_t dpu_index, uint32_t block_index,
+                                  void *args) {
+  codec_sg_context *ctx = (codec_sg_context *)args;
+  if (block_index >= ctx->pageCnt) {
+    return false;
+  }
+  out->addr = (uint8_t *)ctx->codec->slot(block_index, dpu_index);
+  out->length =
+      codec_page_byte(ctx->codec->header(block_index, dpu_index).bitWidth);
+  return true;
+}
+
+void XferCodec::scatter(const std::string &unpackBinary,
+                        void *cpuPageBlkBaseAddr,
+                        const uint32_t dpuPageBaseIdx,
+                        const uint32_t pageBlkCnt) noexcept {
+  DPU_ASSERT(dpu_load(allDPUs, unpackBinary.c_str(), NULL));
+  for (uint32_t roundBase = 0; roundBase < pageBlkCnt;
+       roundBase += CODEC_ROUND_PAGE) {
+    const uint32_t pageCnt =
+        std::min<uint32_t>(CODEC_ROUND_PAGE, pageBlkCnt - roundBase);
+    packRound(cpuPageBlkBaseAddr, roundBase, pageCnt);
+
+    codec_sg_context sgInfo{this, pageCnt};
+    get_block_t get_block_info = {.f = &XferCodec::get_packed_block,
+                                  .args = &sgInfo,
+                                  .args_size = sizeof(sgInfo)};
+    DPU_ASSERT(dpu_push_sg_xfer(
+        allDPUs, DPU_XFER_TO_DPU, "buffer",
+        CODEC_STAGE_PAGE_IDX * PAGE_SIZE_BYTE,
+        pageCnt * CODEC_HEADER_BYTE + maxPayloadByte(pageCnt), &get_block_info,
+        DPU_SG_XFER_DISABLE_LENGTH_CHECK));
+
+    codec_args args;
+    args.dpuTCB.src1PageIdx = CODEC_STAGE_PAGE_IDX;
+    args.dpuTCB.src2PageIdx = 0;
+    args.dpuTCB.dstPageIdx = dpuPageBaseIdx + roundBase;
+    args.dpuTCB.pageCnt = pageCnt;
+    DPU_ASSERT(dpu_broadcast_to(allDPUs, "DPU_INPUT_ARGUMENTS", 0, &args,
+                                sizeof(args), DPU_XFER_DEFAULT));
+    DPU_ASSERT(dpu_launch(allDPUs, DPU_SYNCHRONOUS));
+  }
+}
+
+void XferCodec::gather(const std::string &packBinary, void *cpuPageBlkBaseAddr,
+                       const uint32_t dpuPageBaseIdx,
+                       const uint32_t pageBlkCnt) noexcept {
+  DPU_ASSERT(dpu_load(allDPUs, packBinary.c_str(), NULL));
+  for (uint32_t roundBase = 0; roundBase < pageBlkCnt;
+       roundBase += CODEC_ROUND_PAGE) {
+    const uint32_t pageCnt =
+        std::min<uint32_t>(CODEC_ROUND_PAGE, pageBlkCnt - roundBase);
+    reserve(pageCnt);
+
+    codec_args args;
+    args.dpuTCB.src1PageIdx = dpuPageBaseIdx + roundBase;
+    args.dpuTCB.src2PageIdx = 0;
+    args.dpuTCB.dstPageIdx = CODEC_STAGE_PAGE_IDX;
+    args.dpuTCB.pageCnt = pageCnt;
+    DPU_ASSERT(dpu_broadcast_to(allDPUs, "DPU_INPUT_ARGUMENTS", 0, &args,
+                                sizeof(args), DPU_XFER_DEFAULT));
+    DPU_ASSERT(dpu_launch(allDPUs, DPU_SYNCHRONOUS));
+
+    // Header table first, it tells how many payload bytes each page owns.
+    codec_sg_context sgInfo{this, pageCnt};
+    get_block_t get_header_info = {.f = &XferCodec::get_header_block,
+                                   .args = &sgInfo,
+                                   .args_size = sizeof(sgInfo)};
+    DPU_ASSERT(dpu_push_sg_xfer(
+        allDPUs, DPU_XFER_FROM_DPU, "buffer",
+        CODEC_STAGE_PAGE_IDX * PAGE_SIZE_BYTE, pageCnt * CODEC_HEADER_BYTE,
+        &get_header_info, DPU_SG_XFER_DEFAULT));
+
+    get_block_t get_payload_info = {.f = &XferCodec::get_payload_block,
+                                    .args = &sgInfo,
+                                    .args_size = sizeof(sgInfo)};
+    DPU_ASSERT(dpu_push_sg_xfer(
+        allDPUs, DPU_XFER_FROM_DPU, "buffer",
+        CODEC_STAGE_PAGE_IDX * PAGE_SIZE_BYTE + pageCnt * CODEC_HEADER_BYTE,
+        maxPayloadByte(pageCnt), &get_payload_info,
+        DPU_SG_XFER_DISABLE_LENGTH_CHECK));
+
+    unpackRound(cpuPageBlkBaseAddr, roundBase, pageCnt);
+  }
+}
+
+} // namespace Operator
+} // namespace MetaPB
@@ -14,6 +14,7 @@ __host affine_args DPU_INPUT_ARGUMENTS;
 
 static void AFFINE(T *src1, T *src2, T *dst, T weight) {
   unsigned int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
+  DPU_UNROLL_LOOP
   for (unsigned int i = 0; i < itemNum; i++) {
     dst[i] = weight * src1[i] + src2[i];
   }
@@ -24,6 +25,8 @@ int main(void) {
 
   uint32_t src1PageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.src1PageIdx;
   uint32_t src2PageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.src2PageIdx;
+  uint32_t src2WrapByte =
+      DPU_INPUT_ARGUMENTS.dpuTCB.src2WrapPageCnt * PAGE_SIZE_BYTE;
   uint32_t dstPageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.dstPageIdx;
   uint32_t pageCnt = DPU_INPUT_ARGUMENTS.dpuTCB.pageCnt;
   uint32_t maxOffset = pageCnt * PAGE_SIZE_BYTE;
@@ -45,7 +48,10 @@ int main(void) {
        byte_index < maxOffset; byte_index += DPU_DMA_BFFR_BYTE * NR_TASKLETS) {
 
     __mram_ptr void const *mySrc1 = src1PageBaseAddr + byte_index;
-    __mram_ptr void const *mySrc2 = src2PageBaseAddr + byte_index;
+    // A broadcast src2 repeats, every chunk reads its own slice of it.
+    __mram_ptr void const *mySrc2 =
+        src2PageBaseAddr +
+        (src2WrapByte ? byte_index % src2WrapByte : byte_index);
     __mram_ptr void const *myDst = dstPageBaseAddr + byte_index;
 
     mram_read(mySrc1, cache_A, DPU_DMA_BFFR_BYTE);
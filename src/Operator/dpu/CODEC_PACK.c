@@ -0,0 +1,93 @@
+#include <alloc.h>
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+#include <perfcounter.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Operator/dpu/CODEC.h"
+
+__mram_noinit page_t buffer[NR_SINGLE_DPU_PAGE];
+__host codec_args DPU_INPUT_ARGUMENTS;
+
+BARRIER_INIT(my_barrier, NR_TASKLETS);
+
+codec_header headers[CODEC_ROUND_PAGE];
+
+// Pack one round of raw pages into the MRAM stage, the host gathers the
+// header table first and then only the packed payload.
+int main(void) {
+  unsigned int tasklet_id = me();
+  uint32_t srcPageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.src1PageIdx;
+  uint32_t stagePageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.dstPageIdx;
+  uint32_t pageCnt = DPU_INPUT_ARGUMENTS.dpuTCB.pageCnt;
+  uint32_t headerByte = pageCnt * CODEC_HEADER_BYTE;
+
+  __mram_ptr void const *srcPageBaseAddr =
+      (__mram_ptr void const *)(&buffer[srcPageIdx]);
+  __mram_ptr void const *stageBaseAddr =
+      (__mram_ptr void const *)(&buffer[stagePageIdx]);
+  __mram_ptr void const *payloadBaseAddr = stageBaseAddr + headerByte;
+
+  int32_t *cache_A = (int32_t *)mem_alloc(DPU_DMA_BFFR_BYTE);
+  uint32_t *cache_B = (uint32_t *)mem_alloc(DPU_DMA_BFFR_BYTE);
+
+  // Phase 1: page-wise frame of reference.
+  for (uint32_t page = tasklet_id; page < pageCnt; page += NR_TASKLETS) {
+    int32_t minVal = 0x7FFFFFFF;
+    int32_t maxVal = -0x7FFFFFFF - 1;
+    for (uint32_t sub = 0; sub < CODEC_CHUNK_PER_PAGE; sub++) {
+      mram_read(srcPageBaseAddr + page * PAGE_SIZE_BYTE +
+                    sub * DPU_DMA_BFFR_BYTE,
+                cache_A, DPU_DMA_BFFR_BYTE);
+      for (uint32_t i = 0; i < CODEC_ITEM_PER_CHUNK; i++) {
+        if (cache_A[i] < minVal)
+          minVal = cache_A[i];
+        if (cache_A[i] > maxVal)
+          maxVal = cache_A[i];
+      }
+    }
+    headers[page].base = minVal;
+    headers[page].bitWidth =
+        codec_bit_width((uint32_t)maxVal - (uint32_t)minVal);
+  }
+  barrier_wait(&my_barrier);
+
+  // Phase 2: payload layout, then publish the header table.
+  if (tasklet_id == 0) {
+    uint32_t offset = 0;
+    for (uint32_t page = 0; page < pageCnt; page++) {
+      headers[page].offset = offset;
+      offset += codec_page_byte(headers[page].bitWidth);
+    }
+    for (uint32_t byte_index = 0; byte_index < headerByte;
+         byte_index += 2048) {
+      uint32_t len = headerByte - byte_index < 2048 ? headerByte - byte_index
+                                                     : 2048;
+      mram_write((char *)headers + byte_index, stageBaseAddr + byte_index,
+                 len);
+    }
+  }
+  barrier_wait(&my_barrier);
+
+  // Phase 3: chunk-wise packing.
+  uint32_t chunkNum = pageCnt * CODEC_CHUNK_PER_PAGE;
+  for (uint32_t chunk = tasklet_id; chunk < chunkNum; chunk += NR_TASKLETS) {
+    uint32_t page = chunk / CODEC_CHUNK_PER_PAGE;
+    uint32_t sub = chunk % CODEC_CHUNK_PER_PAGE;
+    codec_header hdr = headers[page];
+    uint32_t chunkByte = codec_chunk_byte(hdr.bitWidth);
+
+    __mram_ptr void const *mySrc =
+        srcPageBaseAddr + page * PAGE_SIZE_BYTE + sub * DPU_DMA_BFFR_BYTE;
+    __mram_ptr void const *myDst =
+        payloadBaseAddr + hdr.offset + sub * chunkByte;
+
+    mram_read(mySrc, cache_A, DPU_DMA_BFFR_BYTE);
+    codec_pack(cache_A, cache_B, hdr.base, hdr.bitWidth, CODEC_ITEM_PER_CHUNK);
+    mram_write(cache_B, myDst, chunkByte);
+  }
+
+  return 0;
+}
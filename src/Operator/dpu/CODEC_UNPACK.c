@@ -0,0 +1,64 @@
+#include <alloc.h>
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+#include <perfcounter.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Operator/dpu/CODEC.h"
+
+__mram_noinit page_t buffer[NR_SINGLE_DPU_PAGE];
+__host codec_args DPU_INPUT_ARGUMENTS;
+
+BARRIER_INIT(my_barrier, NR_TASKLETS);
+
+codec_header headers[CODEC_ROUND_PAGE];
+
+// Unpack one round of packed pages from the MRAM stage into raw pages.
+int main(void) {
+  unsigned int tasklet_id = me();
+  uint32_t stagePageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.src1PageIdx;
+  uint32_t dstPageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.dstPageIdx;
+  uint32_t pageCnt = DPU_INPUT_ARGUMENTS.dpuTCB.pageCnt;
+  uint32_t headerByte = pageCnt * CODEC_HEADER_BYTE;
+
+  __mram_ptr void const *stageBaseAddr =
+      (__mram_ptr void const *)(&buffer[stagePageIdx]);
+  __mram_ptr void const *payloadBaseAddr = stageBaseAddr + headerByte;
+  __mram_ptr void const *dstPageBaseAddr =
+      (__mram_ptr void const *)(&buffer[dstPageIdx]);
+
+  if (tasklet_id == 0) {
+    for (uint32_t byte_index = 0; byte_index < headerByte;
+         byte_index += 2048) {
+      uint32_t len = headerByte - byte_index < 2048 ? headerByte - byte_index
+                                                     : 2048;
+      mram_read(stageBaseAddr + byte_index, (char *)headers + byte_index, len);
+    }
+  }
+  barrier_wait(&my_barrier);
+
+  uint32_t *cache_A = (uint32_t *)mem_alloc(DPU_DMA_BFFR_BYTE);
+  int32_t *cache_B = (int32_t *)mem_alloc(DPU_DMA_BFFR_BYTE);
+
+  uint32_t chunkNum = pageCnt * CODEC_CHUNK_PER_PAGE;
+  for (uint32_t chunk = tasklet_id; chunk < chunkNum; chunk += NR_TASKLETS) {
+    uint32_t page = chunk / CODEC_CHUNK_PER_PAGE;
+    uint32_t sub = chunk % CODEC_CHUNK_PER_PAGE;
+    codec_header hdr = headers[page];
+    uint32_t chunkByte = codec_chunk_byte(hdr.bitWidth);
+
+    __mram_ptr void const *mySrc =
+        payloadBaseAddr + hdr.offset + sub * chunkByte;
+    __mram_ptr void const *myDst =
+        dstPageBaseAddr + page * PAGE_SIZE_BYTE + sub * DPU_DMA_BFFR_BYTE;
+
+    mram_read(mySrc, cache_A, chunkByte);
+    codec_unpack(cache_A, cache_B, hdr.base, hdr.bitWidth,
+                 CODEC_ITEM_PER_CHUNK);
+    mram_write(cache_B, myDst, DPU_DMA_BFFR_BYTE);
+  }
+
+  return 0;
+}
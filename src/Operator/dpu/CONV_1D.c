@@ -11,21 +11,68 @@
 __mram_noinit page_t buffer[NR_SINGLE_DPU_PAGE];
 __host conv_args DPU_INPUT_ARGUMENTS;
 
-static void CONV_1D(T *dst, T *src, T *kernel, int kernelSize, int stride) {
-  unsigned int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
-  size_t padding = (kernelSize - 1) / 2;
-  // Perform convolution
-  for (size_t i = 0; i < itemNum; ++i) {
-    T sum = 0;
-    for (size_t j = 0; j < kernelSize; ++j) {
-      // Compute the input index, considering padding
-      int inputIndex = i - padding + j;
-      // Check if the input index is within bounds
-      if (inputIndex >= 0 && inputIndex < itemNum) {
-        sum += src[inputIndex] * kernel[j];
-      }
+// One zero-padded output, taps falling outside the buffer are skipped.
+static inline T CONV_1D_ITEM(T *src, T *kernel, int kernelSize, int i) {
+  int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
+  int padding = (kernelSize - 1) / 2;
+  T sum = 0;
+  for (int j = 0; j < kernelSize; ++j) {
+    int inputIndex = i - padding + j;
+    if (inputIndex >= 0 && inputIndex < itemNum) {
+      sum += src[inputIndex] * kernel[j];
     }
-    dst[i] = sum;
+  }
+  return sum;
+}
+
+static void CONV_1D(T *dst, T *src, T *kernel, int kernelSize) {
+  const int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
+  for (int i = 0; i < itemNum; ++i) {
+    dst[i] = CONV_1D_ITEM(src, kernel, kernelSize, i);
+  }
+}
+
+// Kernel size fixed at compile time: the taps unroll, only the outputs within
+// padding of either edge check bounds.
+#define DEFINE_CONV_1D_K(K)                                                    \
+  static void CONV_1D_K##K(T *dst, T *src, T *kernel) {                        \
+    const int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);                         \
+    const int padding = (K - 1) / 2;                                           \
+    const int interiorEnd = itemNum - (K - 1 - padding);                       \
+    for (int i = 0; i < padding; ++i)                                          \
+      dst[i] = CONV_1D_ITEM(src, kernel, K, i);                                \
+    DPU_UNROLL_LOOP                                                            \
+    for (int i = padding; i < interiorEnd; ++i) {                              \
+      T *window = src + i - padding;                                           \
+      T sum = 0;                                                               \
+      _Pragma("unroll") for (int j = 0; j < K; ++j)                            \
+        sum += window[j] * kernel[j];                                          \
+      dst[i] = sum;                                                            \
+    }                                                                          \
+    for (int i = interiorEnd; i < itemNum; ++i)                                \
+      dst[i] = CONV_1D_ITEM(src, kernel, K, i);                                \
+  }
+
+DEFINE_CONV_1D_K(3)
+DEFINE_CONV_1D_K(5)
+DEFINE_CONV_1D_K(7)
+DEFINE_CONV_1D_K(8)
+
+typedef void (*conv_fn)(T *, T *, T *);
+
+// Null when the size has no specialisation, CONV_1D then takes it.
+static conv_fn select_conv(int kernelSize) {
+  switch (kernelSize) {
+  case 3:
+    return CONV_1D_K3;
+  case 5:
+    return CONV_1D_K5;
+  case 7:
+    return CONV_1D_K7;
+  case 8:
+    return CONV_1D_K8;
+  default:
+    return NULL;
   }
 }
 
@@ -41,7 +88,7 @@ int main(void) {
   for (int i = 0; i < 8; i++) {
     kernel[i] = DPU_INPUT_ARGUMENTS.gaussianKernel[i];
   }
-  int stride = DPU_INPUT_ARGUMENTS.stride;
+  conv_fn conv = select_conv(kernelSize);
 
   T *cache_A = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
   T *cache_B = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
@@ -58,7 +105,10 @@ int main(void) {
     __mram_ptr void const *myDst = dstPageBaseAddr + byte_index;
 
     mram_read(mySrc1, cache_A, DPU_DMA_BFFR_BYTE);
-    CONV_1D(cache_B, cache_A, kernel, kernelSize, stride);
+    if (conv != NULL)
+      conv(cache_B, cache_A, kernel);
+    else
+      CONV_1D(cache_B, cache_A, kernel, kernelSize);
     mram_write(cache_B, myDst, DPU_DMA_BFFR_BYTE);
   }
   return 0;
@@ -13,6 +13,7 @@ __host DPU_TCB_c dpuTCB;
 
 static void ELEW_ADD(T *src1, T *src2, T *dst) {
   unsigned int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
+  DPU_UNROLL_LOOP
   for (unsigned int i = 0; i < itemNum; i++) {
     dst[i] = src1[i] + src2[i];
   }
@@ -23,6 +24,7 @@ int main(void) {
   unsigned int tasklet_id = me();
   uint32_t src1PageIdx = dpuTCB.src1PageIdx;
   uint32_t src2PageIdx = dpuTCB.src2PageIdx;
+  uint32_t src2WrapByte = dpuTCB.src2WrapPageCnt * PAGE_SIZE_BYTE;
   uint32_t dstPageIdx = dpuTCB.dstPageIdx;
   uint32_t pageCnt = dpuTCB.pageCnt;
   uint32_t maxOffset = pageCnt * PAGE_SIZE_BYTE;
@@ -41,7 +43,10 @@ int main(void) {
   for (unsigned int byte_index = DPU_DMA_BFFR_BYTE * tasklet_id;
        byte_index < maxOffset; byte_index += DPU_DMA_BFFR_BYTE * NR_TASKLETS) {
     __mram_ptr void const *mySrc1 = src1PageBaseAddr + byte_index;
-    __mram_ptr void const *mySrc2 = src2PageBaseAddr + byte_index;
+    // A broadcast src2 repeats, every chunk reads its own slice of it.
+    __mram_ptr void const *mySrc2 =
+        src2PageBaseAddr +
+        (src2WrapByte ? byte_index % src2WrapByte : byte_index);
     __mram_ptr void const *myDst = dstPageBaseAddr + byte_index;
 
     mram_read(mySrc1, cache_A, DPU_DMA_BFFR_BYTE);
@@ -0,0 +1,109 @@
+#include <alloc.h>
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+#include <perfcounter.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Operator/dpu/ELEW_FUSED.h"
+#include "Operator/dpu/PARTIAL.h"
+
+__mram_noinit page_t buffer[NR_SINGLE_DPU_PAGE];
+__host chain_args DPU_INPUT_ARGUMENTS;
+
+BARRIER_INIT(my_barrier, NR_TASKLETS);
+__dma_aligned int64_t partials[NR_TASKLETS];
+
+// Every stage updates the running chunk in place, same arithmetic as the
+// single-operator programs.
+static void STAGE(T *acc, T *src2, unsigned int opCode, T weight) {
+  unsigned int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
+  T sum = 0;
+  switch (opCode) {
+  case CHAIN_OP_ADD:
+    DPU_UNROLL_LOOP
+    for (unsigned int i = 0; i < itemNum; i++) {
+      acc[i] = acc[i] + src2[i];
+    }
+    break;
+  case CHAIN_OP_PROD:
+    DPU_UNROLL_LOOP
+    for (unsigned int i = 0; i < itemNum; i++) {
+      acc[i] = acc[i] * src2[i];
+    }
+    break;
+  case CHAIN_OP_AFFINE:
+    DPU_UNROLL_LOOP
+    for (unsigned int i = 0; i < itemNum; i++) {
+      acc[i] = weight * acc[i] + src2[i];
+    }
+    break;
+  case CHAIN_OP_MAC:
+    DPU_UNROLL_LOOP
+    for (unsigned int i = 0; i < itemNum; i++) {
+      sum += acc[i] * src2[i];
+    }
+    acc[0] = sum;
+    break;
+  case CHAIN_OP_EUDIST:
+    DPU_UNROLL_LOOP
+    for (unsigned int i = 0; i < itemNum; i++) {
+      sum += (src2[i] - acc[i]) * (src2[i] - acc[i]);
+    }
+    acc[0] = sum;
+    break;
+  }
+}
+
+int main(void) {
+
+  unsigned int tasklet_id = me();
+  uint32_t src1PageIdx = DPU_INPUT_ARGUMENTS.src1PageIdx;
+  uint32_t dstPageIdx = DPU_INPUT_ARGUMENTS.dstPageIdx;
+  uint32_t pageCnt = DPU_INPUT_ARGUMENTS.pageCnt;
+  uint32_t stageNum = DPU_INPUT_ARGUMENTS.stageNum;
+  uint32_t maxOffset = pageCnt * PAGE_SIZE_BYTE;
+  // A reduction tail folds the chunks into the DPU partial instead.
+  int isReduced =
+      stageNum > 0 &&
+      DPU_INPUT_ARGUMENTS.stages[stageNum - 1].opCode >= CHAIN_OP_MAC;
+
+  T *cache_A = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
+  T *cache_B = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
+
+  __mram_ptr void const *src1PageBaseAddr =
+      (__mram_ptr void const *)(&buffer[src1PageIdx]);
+  __mram_ptr void const *dstPageBaseAddr =
+      (__mram_ptr void const *)(&buffer[dstPageIdx]);
+
+  // One read of src1 and one write of the last stage per chunk, the
+  // intermediates never leave WRAM.
+  int64_t sum = 0;
+  for (unsigned int byte_index = DPU_DMA_BFFR_BYTE * tasklet_id;
+       byte_index < maxOffset; byte_index += DPU_DMA_BFFR_BYTE * NR_TASKLETS) {
+
+    mram_read(src1PageBaseAddr + byte_index, cache_A, DPU_DMA_BFFR_BYTE);
+    for (uint32_t s = 0; s < stageNum; s++) {
+      const chain_stage *stage = &DPU_INPUT_ARGUMENTS.stages[s];
+      uint32_t src2WrapByte = stage->src2WrapPageCnt * PAGE_SIZE_BYTE;
+      // A broadcast src2 repeats, every chunk reads its own slice of it.
+      __mram_ptr void const *mySrc2 =
+          (__mram_ptr void const *)(&buffer[stage->src2PageIdx]) +
+          (src2WrapByte ? byte_index % src2WrapByte : byte_index);
+      mram_read(mySrc2, cache_B, DPU_DMA_BFFR_BYTE);
+      STAGE(cache_A, cache_B, stage->opCode, stage->weight);
+    }
+    if (isReduced)
+      sum += cache_A[0];
+    else
+      mram_write(cache_A, dstPageBaseAddr + byte_index, DPU_DMA_BFFR_BYTE);
+  }
+  if (isReduced) {
+    partials[tasklet_id] = sum;
+    partial_combine(partials, &my_barrier,
+                    (__mram_ptr void *)(&buffer[DPU_STAT_PAGE_IDX]));
+  }
+
+  return 0;
+}
@@ -6,17 +6,23 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "Operator/dpu/PARTIAL.h"
 #include "Operator/dpu/common.h"
 
 __mram_noinit page_t buffer[NR_SINGLE_DPU_PAGE];
 __host DPU_TCB_c dpuTCB;
 
-static void EUDIST(T *src1, T *src2, T *dst) {
+BARRIER_INIT(my_barrier, NR_TASKLETS);
+__dma_aligned int64_t partials[NR_TASKLETS];
+
+static T EUDIST(T *src1, T *src2) {
   unsigned int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
-  dst[0] = 0;
+  T sum = 0;
+  DPU_UNROLL_LOOP
   for (unsigned int i = 0; i < itemNum; i++) {
-    dst[0] += (src2[i] - src1[i]) * (src2[i] - src1[i]);
+    sum += (src2[i] - src1[i]) * (src2[i] - src1[i]);
   }
+  return sum;
 }
 
 int main(void) {
@@ -24,32 +30,34 @@ int main(void) {
   unsigned int tasklet_id = me();
   uint32_t src1PageIdx = dpuTCB.src1PageIdx;
   uint32_t src2PageIdx = dpuTCB.src2PageIdx;
-  uint32_t dstPageIdx = dpuTCB.dstPageIdx;
+  uint32_t src2WrapByte = dpuTCB.src2WrapPageCnt * PAGE_SIZE_BYTE;
   uint32_t pageCnt = dpuTCB.pageCnt;
   uint32_t maxOffset = pageCnt * PAGE_SIZE_BYTE;
 
   T *cache_A = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
   T *cache_B = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
-  T *cache_C = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
 
   __mram_ptr void const *src1PageBaseAddr =
       (__mram_ptr void const *)(&buffer[src1PageIdx]);
   __mram_ptr void const *src2PageBaseAddr =
       (__mram_ptr void const *)(&buffer[src2PageIdx]);
-  __mram_ptr void const *dstPageBaseAddr =
-      (__mram_ptr void const *)(&buffer[dstPageIdx]);
-  __mram_ptr void const *myDst = dstPageBaseAddr;
 
+  int64_t sum = 0;
   for (unsigned int byte_index = DPU_DMA_BFFR_BYTE * tasklet_id;
        byte_index < maxOffset; byte_index += DPU_DMA_BFFR_BYTE * NR_TASKLETS) {
     __mram_ptr void const *mySrc1 = src1PageBaseAddr + byte_index;
-    __mram_ptr void const *mySrc2 = src2PageBaseAddr + byte_index;
+    // A broadcast src2 repeats, every chunk reads its own slice of it.
+    __mram_ptr void const *mySrc2 =
+        src2PageBaseAddr +
+        (src2WrapByte ? byte_index % src2WrapByte : byte_index);
 
     mram_read(mySrc1, cache_A, DPU_DMA_BFFR_BYTE);
     mram_read(mySrc2, cache_B, DPU_DMA_BFFR_BYTE);
-    EUDIST(cache_A, cache_B, cache_C);
+    sum += EUDIST(cache_A, cache_B);
   }
-  mram_write(cache_C, myDst, DPU_DMA_BFFR_BYTE);
+  partials[tasklet_id] = sum;
+  partial_combine(partials, &my_barrier,
+                  (__mram_ptr void *)(&buffer[DPU_STAT_PAGE_IDX]));
 
   return 0;
 }
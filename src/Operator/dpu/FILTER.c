@@ -6,21 +6,26 @@
 #include <stdint.h>
 #include <stdio.h>
 
-#include "Operator/dpu/CONV_1D.h"
+#include "Operator/dpu/FILTER.h"
 
 __mram_noinit page_t buffer[NR_SINGLE_DPU_PAGE];
-__host conv_args DPU_INPUT_ARGUMENTS;
-
-// do filter for a cache block
-static void FILTER(T *dst, T *src, int kernelSize) {
-  unsigned int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
-  for (size_t i = 0; i < itemNum; i++) {
-    T sum = 0;
-    for (size_t j = 0; j < kernelSize; ++j) {
-      if (i + j < itemNum)
-        sum += src[i + j] / kernelSize;
-    }
-    dst[i] = sum / kernelSize;
+__host filter_args DPU_INPUT_ARGUMENTS;
+
+// do filter for a cache block. The window sum slides through WRAM, each
+// output costs one add, one subtract and a divide by a constant, which the
+// compiler turns into shifts as the DPU has no hardware divider.
+static void FILTER(T *dst, T *src) {
+  const int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
+  T sum = 0;
+  for (int j = 0; j < FILTER_KERNEL_SIZE; ++j) {
+    sum += src[j];
+  }
+  DPU_UNROLL_LOOP
+  for (int i = 0; i < itemNum; i++) {
+    dst[i] = sum / (FILTER_KERNEL_SIZE * FILTER_KERNEL_SIZE);
+    sum -= src[i];
+    if (i + FILTER_KERNEL_SIZE < itemNum)
+      sum += src[i + FILTER_KERNEL_SIZE];
   }
 }
 
@@ -32,8 +37,6 @@ int main(void) {
   uint32_t pageCnt = DPU_INPUT_ARGUMENTS.dpuTCB.pageCnt;
   uint32_t maxOffset = pageCnt * PAGE_SIZE_BYTE;
 
-  int kernelSize = 8;
-
   T *cache_A = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
   T *cache_B = (T *)mem_alloc(DPU_DMA_BFFR_BYTE);
 
@@ -49,7 +52,7 @@ int main(void) {
     __mram_ptr void const *myDst = dstPageBaseAddr + byte_index;
 
     mram_read(mySrc1, cache_A, DPU_DMA_BFFR_BYTE);
-    FILTER(cache_B, cache_A, kernelSize);
+    FILTER(cache_B, cache_A);
     mram_write(cache_B, myDst, DPU_DMA_BFFR_BYTE);
   }
 
@@ -6,24 +6,30 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "Operator/dpu/CODEC.h"
 #include "Operator/dpu/LOOKUP.h"
+#include "Operator/dpu/PARTIAL.h"
 
 __mram_noinit page_t buffer[NR_SINGLE_DPU_PAGE];
 __host lookup_args DPU_INPUT_ARGUMENTS;
 
-static void LOOKUP(T *src, T target, T *dst) {
+BARRIER_INIT(my_barrier, NR_TASKLETS);
+__dma_aligned int64_t partials[NR_TASKLETS];
+
+static T LOOKUP(T *src, T target) {
   unsigned int itemNum = DPU_DMA_BFFR_BYTE / sizeof(T);
-  dst[0] = 0;
+  T hitNum = 0;
+  DPU_UNROLL_LOOP
   for (unsigned int i = 0; i < itemNum; i++) {
     if (src[i] == target)
-      dst[0]++; // sentinel item, counting result number.
+      hitNum++;
   }
+  return hitNum;
 }
 
 int main(void) {
   unsigned int tasklet_id = me();
   uint32_t src1PageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.src1PageIdx;
-  uint32_t dstPageIdx = DPU_INPUT_ARGUMENTS.dpuTCB.dstPageIdx;
   uint32_t pageCnt = DPU_INPUT_ARGUMENTS.dpuTCB.pageCnt;
   uint32_t maxOffset = pageCnt * PAGE_SIZE_BYTE;
 
@@ -34,18 +40,30 @@ int main(void) {
 
   __mram_ptr void const *src1PageBaseAddr =
       (__mram_ptr void const *)(&buffer[src1PageIdx]);
-  __mram_ptr void const *dstPageBaseAddr =
-      (__mram_ptr void const *)(&buffer[dstPageIdx]);
 
+  if (tasklet_id == 0)
+    perfcounter_config(COUNT_CYCLES, true);
+  barrier_wait(&my_barrier);
+
+  int64_t hitNum = 0;
   for (unsigned int byte_index = DPU_DMA_BFFR_BYTE * tasklet_id;
        byte_index < maxOffset; byte_index += DPU_DMA_BFFR_BYTE * NR_TASKLETS) {
 
     __mram_ptr void const *mySrc1 = src1PageBaseAddr + byte_index;
-    __mram_ptr void const *myDst = dstPageBaseAddr + byte_index;
 
     mram_read(mySrc1, cache_A, DPU_DMA_BFFR_BYTE);
-    LOOKUP(cache_A, target, cache_B);
-    mram_write(cache_B, myDst, DPU_DMA_BFFR_BYTE);
+    hitNum += LOOKUP(cache_A, target);
+  }
+  partials[tasklet_id] = hitNum;
+  partial_combine(partials, &my_barrier,
+                  (__mram_ptr void *)(&buffer[DPU_STAT_PAGE_IDX]));
+
+  // Hits cost extra work, the host compares finish cycles across DPUs.
+  if (tasklet_id == 0) {
+    uint64_t *finishCycle = (uint64_t *)cache_B;
+    finishCycle[0] = perfcounter_get();
+    mram_write(finishCycle, (__mram_ptr void *)(&buffer[DPU_STAT_PAGE_IDX]),
+               sizeof(uint64_t));
   }
 
   return 0;
@@ -0,0 +1,81 @@
+// Compiled once per ISA variant, CMake defines one of METAPB_KERNEL_ISA_AVX2
+// or METAPB_KERNEL_ISA_AVX512, none for the scalar variant. The kernels are
+// built under a GCC target pragma rather than -m flags: the standard library
+// is included first, so its inline functions keep the baseline ISA and the
+// linker cannot pick a wider copy for code running on an older host.
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <immintrin.h>
+#include <map>
+#include <omp.h>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+#if defined(METAPB_KERNEL_ISA_AVX512)
+#pragma GCC target("avx512f,avx2,fma,popcnt")
+#define METAPB_KERNEL_ISA avx512
+#define METAPB_KERNEL_AVX512 1
+#elif defined(METAPB_KERNEL_ISA_AVX2)
+// No AVX2 intrinsics path, the scalar loops are vectorised for AVX2.
+#pragma GCC target("avx2,fma,popcnt")
+#define METAPB_KERNEL_ISA avx2
+#else
+#define METAPB_KERNEL_ISA scalar
+#endif
+
+extern "C" {
+#include "Operator/dpu/FILTER.h"
+}
+#include "Operator/CPUKernels.hpp"
+
+namespace MetaPB {
+namespace Operator {
+namespace METAPB_KERNEL_ISA {
+
+namespace {
+void elemwiseSpanOfKind(const ElemwiseKind kind, const int elemType,
+                        const char *src1, const char *src2, char *dst,
+                        const size_t span_Byte,
+                        const std::function<size_t(size_t)> &src2Offset_Byte,
+                        const float weight) {
+  switch (kind) {
+  case ElemwiseKind::ADD:
+    elemwiseSpanOf<ElemwiseKind::ADD>(elemType, src1, src2, dst, span_Byte,
+                                      src2Offset_Byte, weight);
+    break;
+  case ElemwiseKind::PROD:
+    elemwiseSpanOf<ElemwiseKind::PROD>(elemType, src1, src2, dst, span_Byte,
+                                       src2Offset_Byte, weight);
+    break;
+  default:
+    elemwiseSpanOf<ElemwiseKind::AFFINE>(elemType, src1, src2, dst, span_Byte,
+                                         src2Offset_Byte, weight);
+  }
+}
+
+void elemwiseFusedSpanOfStages(const char *src1, char *dst,
+                               const size_t span_Byte,
+                               const std::vector<ElemwiseStage> &stages) {
+  elemwiseFusedSpan(src1, dst, span_Byte, stages);
+}
+} // namespace
+
+const CPUKernelTable &getCPUKernelTable() noexcept {
+  static const CPUKernelTable table = {
+      &elemwiseSpanOfKind,
+      &elemwiseFusedSpanOfStages,
+      &selectConv1DChunk,
+      &filterChunk<FILTER_KERNEL_SIZE>,
+      &reduceChunk<ReduceKind::MAC>,
+      &reduceChunk<ReduceKind::EUDIST>,
+      &countChunk,
+      &combinePartials};
+  return table;
+}
+
+} // namespace METAPB_KERNEL_ISA
+} // namespace Operator
+} // namespace MetaPB
@@ -17,9 +17,9 @@ Schedule HEFTScheduler::schedule() {
     const TaskProperties &tp = graw[tn];
     TaskSchedulingInfo &info = schedulingInfo[tn];
     info.computationCostCPU =
-        om.deducePerfCPU(tp.op, tp.inputSize_MiB).timeCost_Second;
+        om.deducePerfCPU(tp.op, tp.inputSize_MiB, tp.elemType).timeCost_Second;
     info.computationCostDPU =
-        om.deducePerfDPU(tp.op, tp.inputSize_MiB).timeCost_Second;
+        om.deducePerfDPU(tp.op, tp.inputSize_MiB, tp.elemType).timeCost_Second;
   }
 
   // Calculate upward ranks for all tasks
@@ -56,6 +56,7 @@ Schedule HEFTScheduler::schedule() {
   scheduleResult.offloadRatio[boost::num_vertices(graw) - 1] =
       0.0f; // LOGIC_END
   scheduleResult.isAlwaysWrittingBack = false;
+  om.markScheduled();
   return scheduleResult;
 }
 
@@ -99,12 +100,24 @@ void HEFTScheduler::scheduleTask(
       const TaskProperties &sourceNodeProps = graw[pred];
       TaskSchedulingInfo &predInfo = schedulingInfo[pred];
       if (predInfo.assignedProcessor != processor.id) {
+        const double payload_MiB =
+            edgeProps.dataSize_Ratio *
+            (sourceNodeProps.op != OperatorTag::LOGIC_START
+                 ? om.getOutputSize_MiB(sourceNodeProps.op,
+                                        sourceNodeProps.inputSize_MiB)
+                 : 0);
+        // A broadcast operand lands on every DPU at once, priced per page
+        // each DPU holds instead of per page block.
+        const uint32_t bcastPageCnt =
+            processor.id != 0 && edgeProps.isBroadcast &&
+                    Operator::bcastOperandOPSet.contains(graw[tn].op)
+                ? om.getBcastPageCnt(payload_MiB)
+                : 0;
         double transferCost =
             om.deducePerfCPU(OperatorTag::MAP,
-                             edgeProps.dataSize_Ratio *
-                                 (sourceNodeProps.op != OperatorTag::LOGIC_START
-                                      ? sourceNodeProps.inputSize_MiB
-                                      : 0))
+                             bcastPageCnt
+                                 ? bcastPageCnt
+                                 : om.getNearestPageBlkCnt(payload_MiB))
                 .timeCost_Second;
         earliestStartTime =
             std::max(earliestStartTime, predInfo.endTime + transferCost);
@@ -29,7 +29,16 @@ MetaScheduler::evalSchedules(const vector<vector<float>> &ratioVecs) {
   omp_set_num_threads(agentNum);
 #pragma omp parallel for schedule(static)
   for (int i = 0; i < agentNum; i++) {
-    stats[i] = pools[i].execWorkload(tg, proposedSchedule[i], execType::MIMIC);
+    stats[i] = pools[i].execWorkload(nodeNum > 1 ? partTg : tg,
+                                     proposedSchedule[i], execType::MIMIC);
+  }
+  // Nodes run concurrently, energy is paid by every one of them.
+  if (nodeNum > 1) {
+    for (auto &stat : stats) {
+      stat.timeCost_Second += netCost.timeCost_Second;
+      stat.energyCost_Joule =
+          stat.energyCost_Joule * nodeNum + netCost.energyCost_Joule;
+    }
   }
   for (int i = 0; i < stats.size(); i++) {
     float scheduleEval = (Arg_Alpha * 200 * stats[i].timeCost_Second +
@@ -129,6 +138,7 @@ oVec.push_back(std::make_unique<Optimizer::OptimizerRSA<float, float>>(
     std::cout << actualRatio[i] << ",";
   }
   std::cout << std::endl;
+  om.markScheduled();
   return {false, this->HEFTorder, actualRatio};
 }
 
@@ -0,0 +1,75 @@
+#include "utils/DatasetSource.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace MetaPB {
+namespace utils {
+
+DatasetSource::DatasetSource(const std::string &path,
+                             const size_t pageBlkSize) noexcept
+    : path(path), pageBlkSize(pageBlkSize) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "DatasetSource: cannot open " << path << ": "
+              << strerror(errno) << std::endl;
+    return;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    std::cerr << "DatasetSource: empty or unreadable " << path << std::endl;
+    close(fd);
+    return;
+  }
+  fileSize_Byte = st.st_size;
+  mappedSize_Byte =
+      (fileSize_Byte + pageBlkSize - 1) / pageBlkSize * pageBlkSize;
+
+  // Reserve zero pages for the whole padded range, then overlay the file.
+  void *reserved = mmap(nullptr, mappedSize_Byte, PROT_READ,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (reserved == MAP_FAILED) {
+    std::cerr << "DatasetSource: cannot reserve " << mappedSize_Byte
+              << " bytes for " << path << std::endl;
+    close(fd);
+    mappedSize_Byte = 0;
+    return;
+  }
+  void *mapped = mmap(reserved, fileSize_Byte, PROT_READ,
+                      MAP_PRIVATE | MAP_FIXED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    std::cerr << "DatasetSource: cannot map " << path << ": "
+              << strerror(errno) << std::endl;
+    munmap(reserved, mappedSize_Byte);
+    mappedSize_Byte = 0;
+    return;
+  }
+  base = (char *)mapped;
+
+  // Hints only, inputs are streamed once from front to back.
+  madvise(base, mappedSize_Byte, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+  madvise(base, mappedSize_Byte, MADV_HUGEPAGE);
+#endif
+}
+
+DatasetSource::DatasetSource(DatasetSource &&other) noexcept
+    : path(std::move(other.path)), pageBlkSize(other.pageBlkSize),
+      fileSize_Byte(std::exchange(other.fileSize_Byte, 0)),
+      mappedSize_Byte(std::exchange(other.mappedSize_Byte, 0)),
+      base(std::exchange(other.base, nullptr)) {}
+
+DatasetSource::~DatasetSource() noexcept {
+  if (base != nullptr) {
+    munmap(base, mappedSize_Byte);
+  }
+}
+
+} // namespace utils
+} // namespace MetaPB
@@ -0,0 +1,135 @@
+#include "utils/OutputCache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace MetaPB {
+namespace utils {
+
+uint64_t OutputCache::hashBytes(const void *addr,
+                                const size_t size_Byte) noexcept {
+  // Four independent multiply-xorshift lanes over 32-byte strides, wide
+  // enough for the compiler to keep them in one vector register.
+  constexpr uint64_t prime = 0x9fb21c651e98df25ull;
+  uint64_t lane[4] = {0x243f6a8885a308d3ull, 0x13198a2e03707344ull,
+                      0xa4093822299f31d0ull, 0x082efa98ec4e6c89ull};
+  const char *p = (const char *)addr;
+  const size_t strideNum = size_Byte / sizeof(lane);
+  for (size_t s = 0; s < strideNum; s++) {
+    uint64_t word[4];
+    std::memcpy(word, p + s * sizeof(lane), sizeof(lane));
+    for (int l = 0; l < 4; l++) {
+      lane[l] = (lane[l] ^ word[l]) * prime;
+      lane[l] ^= lane[l] >> 29;
+    }
+  }
+  uint64_t tail = 0;
+  std::memcpy(&tail, p + strideNum * sizeof(lane),
+              std::min(size_Byte % sizeof(lane), sizeof(tail)));
+  uint64_t hash = size_Byte;
+  for (int l = 0; l < 4; l++)
+    hash = combine(hash, lane[l]);
+  // Tail bytes beyond the first word of a partial stride.
+  for (size_t i = strideNum * sizeof(lane) + sizeof(tail); i < size_Byte; i++)
+    hash = combine(hash, (uint8_t)p[i]);
+  return combine(hash, tail);
+}
+
+bool OutputCache::pin(const uint64_t key) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries.find(key);
+  if (it == entries.end() || !isComplete(it->second))
+    return false;
+  it->second.isPinned = true;
+  lru.splice(lru.begin(), lru, it->second.lruPos);
+  return true;
+}
+
+void OutputCache::unpinAll() noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Every piece of the run has landed, an entry still short lost one and
+  // would neither complete nor be evicted.
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (!isComplete(it->second)) {
+      cached_Byte -= it->second.bytes.size();
+      lru.erase(it->second.lruPos);
+      it = entries.erase(it);
+      continue;
+    }
+    it->second.isPinned = false;
+    ++it;
+  }
+}
+
+bool OutputCache::restore(const uint64_t key, void *dst,
+                          const size_t size_Byte) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries.find(key);
+  if (it == entries.end() || !isComplete(it->second) ||
+      it->second.bytes.size() != size_Byte) {
+    std::cerr << "OutputCache: entry " << std::hex << key << std::dec
+              << " vanished or changed size" << std::endl;
+    return false;
+  }
+  std::memcpy(dst, it->second.bytes.data(), size_Byte);
+  return true;
+}
+
+void OutputCache::fill(const uint64_t key, const size_t size_Byte,
+                       const size_t offset_Byte, const void *src,
+                       const size_t pieceSize_Byte) noexcept {
+  if (size_Byte > budget_Byte || offset_Byte + pieceSize_Byte > size_Byte)
+    return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries.find(key);
+  if (it == entries.end()) {
+    evictFor(size_Byte);
+    if (cached_Byte + size_Byte > budget_Byte)
+      return; // the rest is pinned or still filling
+    lru.push_front(key);
+    it = entries.emplace(key, entry{}).first;
+    it->second.bytes.resize(size_Byte);
+    it->second.lruPos = lru.begin();
+    cached_Byte += size_Byte;
+  }
+  entry &e = it->second;
+  if (isComplete(e) || e.bytes.size() != size_Byte)
+    return;
+  std::memcpy(e.bytes.data() + offset_Byte, src, pieceSize_Byte);
+  e.filled_Byte += pieceSize_Byte;
+}
+
+void OutputCache::evictFor(const size_t size_Byte) noexcept {
+  auto pos = lru.end();
+  while (cached_Byte + size_Byte > budget_Byte && pos != lru.begin()) {
+    --pos;
+    entry &victim = entries.at(*pos);
+    if (victim.isPinned || !isComplete(victim))
+      continue;
+    cached_Byte -= victim.bytes.size();
+    entries.erase(*pos);
+    pos = lru.erase(pos);
+  }
+}
+
+void OutputCache::recordHit(const perfStats &savedPerf) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  hitNum++;
+  saved = saved + savedPerf;
+}
+
+void OutputCache::recordMiss() noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  missNum++;
+}
+
+void OutputCache::printReport() const noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::cout << "Output cache: " << hitNum << " hits, " << missNum
+            << " misses, " << (double)cached_Byte / (1 << 20)
+            << " MiB held, saved " << saved.timeCost_Second << " s / "
+            << saved.energyCost_Joule << " J (modeled)" << std::endl;
+}
+
+} // namespace utils
+} // namespace MetaPB
@@ -0,0 +1,179 @@
+#include "utils/ResultSink.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <iostream>
+#include <unistd.h>
+
+namespace MetaPB {
+namespace utils {
+
+ResultSink::ResultSink(const std::string &dirPath) noexcept
+    : dirPath(dirPath) {
+  std::error_code ec;
+  std::filesystem::create_directories(dirPath, ec);
+  if (ec) {
+    std::cerr << "ResultSink: cannot create " << dirPath << ": "
+              << ec.message() << std::endl;
+  }
+  for (auto &stage : stages) {
+    stage.data = (char *)std::aligned_alloc(SINK_STAGE_ALIGN_BYTE,
+                                            SINK_WRITE_CHUNK_BYTE);
+    if (stage.data == nullptr) {
+      std::cerr << "ResultSink: cannot allocate the staging buffers"
+                << std::endl;
+      std::abort();
+    }
+  }
+  stager = std::thread(&ResultSink::stagerLoop, this);
+  writer = std::thread(&ResultSink::writerLoop, this);
+}
+
+ResultSink::~ResultSink() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    isStopping = true;
+  }
+  cv_.notify_all();
+  stager.join();
+  writer.join();
+  for (auto &stage : stages) {
+    std::free(stage.data);
+  }
+  for (auto &[_, fd] : stream2Fd) {
+    close(fd);
+  }
+}
+
+int ResultSink::getStreamFd(const std::string &streamName) noexcept {
+  if (!stream2Fd.contains(streamName)) {
+    std::string path = dirPath + "/" + streamName + ".bin";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      std::cerr << "ResultSink: cannot open " << path << ": "
+                << strerror(errno) << std::endl;
+      return -1;
+    }
+    stream2Fd[streamName] = fd;
+  }
+  return stream2Fd[streamName];
+}
+
+void ResultSink::submit(const std::string &streamName, const void *addr,
+                        const size_t size_Byte,
+                        const off_t fileOffset_Byte) noexcept {
+  if (size_Byte == 0)
+    return;
+  std::unique_lock<std::mutex> lock(mutex_);
+  int fd = getStreamFd(streamName);
+  if (fd < 0)
+    return;
+  jobs.push_back({fd, (const char *)addr, size_Byte, fileOffset_Byte});
+  const uint64_t ticket = ++submittedJobNum;
+  cv_.notify_one();
+  // Only the copy is waited for, the pwrite of the staged chunks runs behind.
+  staged_.wait(lock, [this, ticket] { return stagedJobNum >= ticket; });
+}
+
+void ResultSink::drain() noexcept {
+  std::unique_lock<std::mutex> lock(mutex_);
+  drained_.wait(lock, [this] {
+    return stagedJobNum == submittedJobNum && !stages[0].isFull &&
+           !stages[1].isFull;
+  });
+}
+
+void ResultSink::stagerLoop() noexcept {
+  size_t stageIdx = 0;
+  while (true) {
+    writeJob job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return isStopping || !jobs.empty(); });
+      if (jobs.empty()) // stopping and nothing left
+        break;
+      job = jobs.front();
+      jobs.pop_front();
+    }
+
+    // Chunks alternate between the buffers, the writer drains them in the
+    // same order.
+    for (size_t done_Byte = 0; done_Byte < job.size_Byte;) {
+      const size_t len =
+          std::min<size_t>(SINK_WRITE_CHUNK_BYTE, job.size_Byte - done_Byte);
+      stageBuffer &stage = stages[stageIdx];
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stageFree_.wait(lock, [&stage] { return !stage.isFull; });
+      }
+      memcpy(stage.data, job.addr + done_Byte, len);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stage.fd = job.fd;
+        stage.size_Byte = len;
+        stage.fileOffset_Byte = job.fileOffset_Byte + done_Byte;
+        stage.isFull = true;
+      }
+      stageFull_.notify_one();
+      stageIdx ^= 1;
+      done_Byte += len;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stagedJobNum++;
+    }
+    staged_.notify_all();
+    drained_.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    isStagerDone = true;
+  }
+  stageFull_.notify_one();
+}
+
+void ResultSink::writerLoop() noexcept {
+  size_t stageIdx = 0;
+  while (true) {
+    stageBuffer &stage = stages[stageIdx];
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stageFull_.wait(lock,
+                      [this, &stage] { return stage.isFull || isStagerDone; });
+      if (!stage.isFull) // stager gone and every chunk written
+        return;
+    }
+
+    size_t done_Byte = 0;
+    while (done_Byte < stage.size_Byte) {
+      ssize_t ret = pwrite(stage.fd, stage.data + done_Byte,
+                           stage.size_Byte - done_Byte,
+                           stage.fileOffset_Byte + done_Byte);
+      if (ret < 0) {
+        if (errno == EINTR)
+          continue;
+        std::cerr << "ResultSink: write failed: " << strerror(errno)
+                  << std::endl;
+        break;
+      }
+      done_Byte += ret;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      written_Byte += done_Byte;
+      stage.isFull = false;
+    }
+    stageFree_.notify_one();
+    drained_.notify_all();
+    stageIdx ^= 1;
+  }
+}
+
+} // namespace utils
+} // namespace MetaPB
@@ -0,0 +1,121 @@
+#include "Operator/ConvKernel.hpp"
+#include "Operator/FilterKernel.hpp"
+#include "Operator/ReduceKernel.hpp"
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace MetaPB::Operator;
+
+// Host chunk kernels against plain scalar references. Every case gets its own
+// exact-size operands, so an access past itemNum is caught by the sanitizers.
+
+// One full chunk, lengths that leave a tail after every unrolled or vector
+// step, and chunks shorter than any conv padding or filter window.
+static const std::vector<uint32_t> itemNums = {256, 83, 21, 17, 16,
+                                               5,   3,  2,  1,  0};
+static const int taps[8] = {8, 1, 1, 3, 3, 1, 1, 8};
+
+/// @brief Runs check on two operands of every length, from a narrow range
+/// through to bound, the widest items whose results still fit an int.
+template <typename Check> bool forEachCase(const int bound, Check check) {
+  std::mt19937 rng(42);
+  bool isPassed = true;
+  for (const int range : {4, 1000, bound}) {
+    std::uniform_int_distribution<int> dist(-range, range);
+    for (const uint32_t itemNum : itemNums) {
+      std::vector<int> a(itemNum), b(itemNum);
+      for (uint32_t i = 0; i < itemNum; i++) {
+        a[i] = dist(rng);
+        b[i] = dist(rng);
+      }
+      isPassed = isPassed && check(a, b);
+    }
+  }
+  return isPassed;
+}
+
+template <int K> bool checkConv(const std::vector<int> &src) {
+  const int itemNum = src.size();
+  std::vector<int> dst(itemNum), ref(itemNum);
+  selectConv1DChunk(K)(src.data(), dst.data(), taps, itemNum);
+  conv1DChunkGeneric(src.data(), ref.data(), taps, K, itemNum);
+  return dst == ref;
+}
+
+template <int K> bool checkFilter(const std::vector<int> &src) {
+  const int itemNum = src.size();
+  std::vector<int> dst(itemNum);
+  filterChunk<K>(src.data(), dst.data(), itemNum);
+  bool isPassed = true;
+  for (int i = 0; i < itemNum; i++) {
+    int sum = 0;
+    for (int j = i; j < i + K && j < itemNum; j++) {
+      sum += src[j];
+    }
+    isPassed = isPassed && dst[i] == sum / (K * K);
+  }
+  return isPassed;
+}
+
+template <ReduceKind kind>
+bool checkReduce(const std::vector<int> &a, const std::vector<int> &b) {
+  int ref = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    ref += reduceItem<kind>(a[i], b[i]);
+  }
+  return reduceChunk<kind>(a.data(), b.data(), a.size()) == ref;
+}
+
+bool checkCount(const std::vector<int> &src) {
+  int ref = 0;
+  for (const int item : src) {
+    ref += item == 2;
+  }
+  return countChunk(src.data(), 2, src.size()) == ref;
+}
+
+int main() {
+  // Conv outputs weigh up to the sum of the taps, filter windows up to eight
+  // items, reductions a full chunk of squared differences.
+  const bool isConvPassed =
+      forEachCase(INT_MAX / 26,
+                  [](const auto &a, const auto &) {
+                    return checkConv<3>(a) && checkConv<5>(a) &&
+                           checkConv<7>(a) && checkConv<8>(a);
+                  }) &&
+      selectConv1DChunk(9) == nullptr;
+  const bool isFilterPassed =
+      forEachCase(INT_MAX / 8, [](const auto &a, const auto &) {
+        return checkFilter<8>(a) && checkFilter<4>(a) && checkFilter<3>(a) &&
+               checkFilter<1>(a);
+      });
+  bool isReducePassed = forEachCase(1448, [](const auto &a, const auto &b) {
+    return checkReduce<ReduceKind::MAC>(a, b) &&
+           checkReduce<ReduceKind::EUDIST>(a, b) && checkCount(a);
+  });
+
+  // Per-DPU partials past int range, the host combine must stay in int64.
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int64_t> dist(-4, 4);
+  for (const uint32_t partialNum : {2530u, 16u, 5u, 1u, 0u}) {
+    std::vector<int64_t> partials(partialNum);
+    int64_t ref = 0;
+    for (int64_t &partial : partials) {
+      partial = dist(rng) << 33;
+      ref += partial;
+    }
+    isReducePassed = isReducePassed &&
+                     combinePartials(partials.data(), partialNum) == ref;
+  }
+
+  std::cout << "CONV_1D kernels: " << (isConvPassed ? "PASSED" : "FAILED")
+            << std::endl;
+  std::cout << "FILTER kernel: " << (isFilterPassed ? "PASSED" : "FAILED")
+            << std::endl;
+  std::cout << "Reduction kernels: " << (isReducePassed ? "PASSED" : "FAILED")
+            << std::endl;
+  return isConvPassed && isFilterPassed && isReducePassed ? 0 : 1;
+}
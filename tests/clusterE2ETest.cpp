@@ -0,0 +1,108 @@
+#include "Distributed/Coordinator.hpp"
+#include "Distributed/Worker.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace MetaPB::Distributed;
+using MetaPB::Executor::TaskProperties;
+using MetaPB::Executor::TransferProperties;
+using MetaPB::Operator::OperatorTag;
+using MetaPB::Operator::OperatorType;
+
+// Two real Worker processes on the emulated DPU backend, driven by a real
+// Coordinator: every node executes its partition in DO mode and the merged
+// report carries the modeled network cost. Boundary data itself never
+// crosses the wire, workers read their share from their own pool.
+int main() {
+  const uint32_t nodeNum = 2;
+  const uint32_t dpuNum = 16;
+  const size_t memPool_GiB = 1;
+
+  TaskProperties start = {OperatorTag::LOGIC_START, OperatorType::Logical, 64,
+                          "yellow", "START"};
+  TaskProperties op = {OperatorTag::EUDIST, OperatorType::MemoryBound, 64, "",
+                       "OP"};
+  TaskProperties end = {OperatorTag::LOGIC_END, OperatorType::Logical, 64,
+                        "black", "END"};
+  TransferProperties logicConnect = {1.0f, true};
+  Graph g;
+  auto startNode = boost::add_vertex(start, g);
+  auto opNode = boost::add_vertex(op, g);
+  auto endNode = boost::add_vertex(end, g);
+  boost::add_edge(startNode, opNode, logicConnect, g);
+  boost::add_edge(opNode, endNode, logicConnect, g);
+  TaskGraph tg(g, "clusterE2ETest");
+
+  // Workers are forked before anything spawns a thread, each one owns its
+  // OperatorManager, emulated DPU set and pool.
+  std::vector<std::string> endpoints;
+  std::vector<pid_t> pids;
+  for (uint32_t i = 0; i < nodeNum; i++) {
+    const std::string endpoint =
+        "unix:/tmp/MetaPB_clusterE2ETest_" + std::to_string(i) + ".sock";
+    pid_t pid = fork();
+    if (pid == 0) {
+      void **memPool = (void **)malloc(3 * sizeof(void *));
+      memPool[0] = malloc(memPool_GiB * size_t(1 << 30));
+      if (memPool[0] == nullptr)
+        _exit(1);
+      memPool[1] = memPool[0];
+      memPool[2] = memPool[0];
+      {
+        OperatorManager om(dpuNum);
+        Worker worker(om, memPool);
+        worker.serve(endpoint);
+      }
+      free(memPool[0]);
+      free((void *)memPool);
+      _exit(0);
+    }
+    endpoints.push_back(endpoint);
+    pids.push_back(pid);
+  }
+
+  // A probe connection is only accepted once the worker listens, the worker
+  // drops it and goes back to accepting.
+  bool isPassed = true;
+  for (const auto &endpoint : endpoints) {
+    bool isUp = false;
+    for (int retry = 0; retry < 100 && !isUp; retry++) {
+      isUp = SocketTransport::connectTo(endpoint) != nullptr;
+      if (!isUp)
+        usleep(100000);
+    }
+    isPassed = isPassed && isUp;
+  }
+
+  perfStats perf;
+  NetworkModel net;
+  if (isPassed) {
+    Coordinator coordinator(endpoints, net, dpuNum);
+    Schedule sched = {false, {0, 1, 2}, {0.0f, 0.5f, 0.0f}};
+    isPassed = coordinator.isValid() && coordinator.getNodeNum() == nodeNum;
+    if (isPassed)
+      perf = coordinator.execWorkload(tg, sched, execType::DO);
+    coordinator.shutdownWorkers();
+  }
+
+  for (const pid_t pid : pids) {
+    int status = 0;
+    if (!isPassed)
+      kill(pid, SIGTERM);
+    isPassed = waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+               WEXITSTATUS(status) == 0 && isPassed;
+  }
+
+  // Both nodes ran, and the shared link is charged for the boundary.
+  const double netTime_Second =
+      net.deduceXfer(boundaryXfer_MiB(tg, dpuNum), 2 * nodeNum)
+          .timeCost_Second;
+  isPassed = isPassed && perf.timeCost_Second > netTime_Second;
+  std::cout << "Cluster of " << nodeNum << " emulated workers, "
+            << perf.timeCost_Second << " s: "
+            << (isPassed ? "PASSED" : "FAILED") << std::endl;
+  return isPassed ? 0 : 1;
+}
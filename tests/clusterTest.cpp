@@ -0,0 +1,114 @@
+#include "Distributed/ClusterModel.hpp"
+#include "Distributed/Transport.hpp"
+#include "Distributed/Wire.hpp"
+#include <csignal>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace MetaPB::Distributed;
+using MetaPB::Executor::TaskProperties;
+using MetaPB::Executor::TransferProperties;
+using MetaPB::Operator::OperatorTag;
+using MetaPB::Operator::OperatorType;
+
+// Loopback cluster on one box: a forked echo worker decodes the job and
+// answers with the total input it received, the coordinator side checks the
+// graph survived the wire and that partitions cover the whole batch.
+int main() {
+  const std::string endpoint = "unix:/tmp/MetaPB_clusterTest.sock";
+  const uint32_t nodeNum = 3;
+
+  TaskProperties start = {OperatorTag::LOGIC_START, OperatorType::Logical,
+                          1000, "yellow", "START"};
+  TaskProperties op = {OperatorTag::EUDIST, OperatorType::MemoryBound, 1000,
+                       "", "OP"};
+  TaskProperties end = {OperatorTag::LOGIC_END, OperatorType::Logical, 1000,
+                        "black", "END"};
+  TransferProperties logicConnect = {1.0f, true};
+  Graph g;
+  auto startNode = boost::add_vertex(start, g);
+  auto opNode = boost::add_vertex(op, g);
+  auto endNode = boost::add_vertex(end, g);
+  boost::add_edge(startNode, opNode, logicConnect, g);
+  boost::add_edge(opNode, endNode, logicConnect, g);
+  TaskGraph tg(g, "clusterTest");
+
+  SocketListener listener(endpoint);
+  pid_t pid = fork();
+  if (pid == 0) { // echo worker
+    auto peer = listener.accept();
+    MsgKind kind;
+    std::vector<char> payload;
+    while (peer != nullptr && peer->recvFrame(kind, payload) &&
+           kind == MsgKind::EXEC_MIMIC) {
+      WireReader r(payload);
+      TaskGraph part;
+      Schedule sched;
+      perfStats perf;
+      if (decodeGraph(r, part) && decodeSchedule(r, sched)) {
+        perf.dataMovement_MiB = part.g[1].inputSize_MiB;
+        perf.timeCost_Second = sched.offloadRatio[1];
+      }
+      std::vector<char> reply;
+      WireWriter w(reply);
+      encodePerf(w, perf);
+      peer->sendFrame(MsgKind::RESULT, reply);
+    }
+    return 0;
+  }
+
+  auto worker = SocketTransport::connectTo(endpoint);
+  if (worker == nullptr) {
+    std::cerr << "cannot reach the echo worker" << std::endl;
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+    return 1;
+  }
+  Schedule sched = {false, {0, 1, 2}, {0.0f, 0.5f, 0.0f}};
+  size_t coveredSize_MiB = 0;
+  bool isPassed = true;
+  for (uint32_t i = 0; i < nodeNum && isPassed; i++) {
+    std::vector<char> job;
+    WireWriter w(job);
+    encodeGraph(w, partitionGraph(tg, i, nodeNum));
+    encodeSchedule(w, sched);
+    MsgKind kind;
+    std::vector<char> reply;
+    WireReader r(reply);
+    perfStats perf;
+    isPassed = worker->sendFrame(MsgKind::EXEC_MIMIC, job) &&
+               worker->recvFrame(kind, reply) && kind == MsgKind::RESULT &&
+               decodePerf(r, perf) && perf.timeCost_Second == 0.5f;
+    coveredSize_MiB += perf.dataMovement_MiB;
+  }
+  worker->sendFrame(MsgKind::SHUTDOWN, {});
+  waitpid(pid, nullptr, 0);
+
+  isPassed = isPassed && coveredSize_MiB == 1000;
+  // A length past TRANSPORT_MAX_FRAME_BYTE is refused before it sizes the
+  // payload.
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0) {
+    SocketTransport tx(fds[0]), rx(fds[1]);
+    const uint32_t kindRaw = (uint32_t)MsgKind::RESULT;
+    const uint64_t size_Byte = 1ull << 62;
+    MsgKind kind;
+    std::vector<char> payload;
+    isPassed = isPassed && tx.sendAll(&kindRaw, sizeof(kindRaw)) &&
+               tx.sendAll(&size_Byte, sizeof(size_Byte)) &&
+               !rx.recvFrame(kind, payload) && payload.empty();
+  } else {
+    isPassed = false;
+  }
+  // START->OP moves 1000MiB in, EUDIST leaves one int64 partial per DPU.
+  const uint32_t dpuNum = 64;
+  const double boundary_MiB = boundaryXfer_MiB(tg, dpuNum);
+  isPassed = isPassed &&
+             std::abs(boundary_MiB - (1000 + dpuNum * 8.0 / (1 << 20))) < 1e-9;
+  std::cout << "Partitions cover " << coveredSize_MiB << " MiB, boundary "
+            << boundary_MiB << " MiB: " << (isPassed ? "PASSED" : "FAILED")
+            << std::endl;
+  return isPassed ? 0 : 1;
+}
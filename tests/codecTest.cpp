@@ -0,0 +1,69 @@
+extern "C" {
+#include "Operator/dpu/CODEC.h"
+}
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// A page packed at the width codec_bit_width picks for its range unpacks to
+// the same items, whole and one DMA chunk at a time as the DPU reads it.
+bool checkPage(const std::vector<int32_t> &page) {
+  int32_t base = page[0], top = page[0];
+  for (const int32_t v : page) {
+    base = std::min(base, v);
+    top = std::max(top, v);
+  }
+  const uint32_t bitWidth = codec_bit_width((uint32_t)top - (uint32_t)base);
+  std::vector<uint32_t> packed(CODEC_ITEM_PER_PAGE + 1, 0xDEADBEEF);
+  codec_pack(page.data(), packed.data(), base, bitWidth, CODEC_ITEM_PER_PAGE);
+  // Packing must stay inside codec_page_byte, the stage is laid out by it.
+  bool isPassed = packed[codec_page_byte(bitWidth) / 4] == 0xDEADBEEF;
+
+  std::vector<int32_t> got(CODEC_ITEM_PER_PAGE);
+  codec_unpack(packed.data(), got.data(), base, bitWidth, CODEC_ITEM_PER_PAGE);
+  isPassed = isPassed && got == page;
+
+  isPassed = isPassed && codec_chunk_byte(bitWidth) % 8 == 0;
+  for (uint32_t chunk = 0; chunk < CODEC_CHUNK_PER_PAGE; chunk++) {
+    codec_unpack(packed.data() + chunk * codec_chunk_byte(bitWidth) / 4,
+                 got.data(), base, bitWidth, CODEC_ITEM_PER_CHUNK);
+    for (uint32_t i = 0; i < CODEC_ITEM_PER_CHUNK; i++)
+      isPassed =
+          isPassed && got[i] == page[chunk * CODEC_ITEM_PER_CHUNK + i];
+  }
+  return isPassed;
+}
+
+int main() {
+  std::mt19937 rng(42);
+  std::vector<int32_t> page(CODEC_ITEM_PER_PAGE);
+  bool isPassed = true;
+
+  // Constant pages still take one bit.
+  std::fill(page.begin(), page.end(), -7);
+  isPassed = isPassed && checkPage(page) && codec_bit_width(0) == 1;
+  // Every width up to raw pages, around a negative base. Both ends of the
+  // range are pinned so the page needs exactly bitWidth bits.
+  for (uint32_t bitWidth = 1; bitWidth <= 32; bitWidth++) {
+    const int64_t range = (1ll << bitWidth) - 1;
+    const int64_t base = bitWidth < 32 ? INT32_MIN / 2 : INT32_MIN;
+    std::uniform_int_distribution<int64_t> dist(0, range);
+    for (auto &v : page)
+      v = (int32_t)(base + dist(rng));
+    page.front() = (int32_t)base;
+    page.back() = (int32_t)(base + range);
+    isPassed = isPassed && checkPage(page) &&
+               codec_bit_width((uint32_t)range) == bitWidth;
+  }
+  // Both extremes in one page need all 32 bits.
+  for (size_t i = 0; i < page.size(); i++)
+    page[i] = i % 2 ? INT32_MAX : INT32_MIN;
+  isPassed = isPassed && checkPage(page) &&
+             codec_bit_width((uint32_t)INT32_MAX - (uint32_t)INT32_MIN) == 32;
+
+  std::cout << "CODEC round trip: " << (isPassed ? "PASSED" : "FAILED")
+            << std::endl;
+  return isPassed ? 0 : 1;
+}
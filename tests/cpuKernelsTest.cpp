@@ -0,0 +1,98 @@
+#include "Operator/CPUKernels.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace MetaPB::Operator;
+
+// Every ISA variant the host runs gives the scalar variant's results.
+bool checkTable(const CPUKernelTable &ref, const CPUKernelTable &isa,
+                const std::vector<int> &a, const std::vector<int> &b) {
+  const size_t span_Byte = 16 * DPU_DMA_BFFR_BYTE;
+  const size_t itemNum = span_Byte / sizeof(int);
+  const char *src1 = (const char *)(a.data() + 1);
+  const char *src2 = (const char *)(b.data() + 1);
+  auto identity = [](size_t offset) { return offset; };
+  std::vector<int> want(itemNum), got(itemNum);
+  std::vector<float> fa(a.begin() + 1, a.begin() + 1 + itemNum),
+      fb(b.begin() + 1, b.begin() + 1 + itemNum), fwant(itemNum),
+      fgot(itemNum);
+  bool isPassed = true;
+
+  for (const ElemwiseKind kind :
+       {ElemwiseKind::ADD, ElemwiseKind::PROD, ElemwiseKind::AFFINE}) {
+    for (const int elemType : {INT32_32ALN, CHAR8_32ALN}) {
+      ref.elemwiseSpan(kind, elemType, src1, src2, (char *)want.data(),
+                       span_Byte, identity, 2.5f);
+      isa.elemwiseSpan(kind, elemType, src1, src2, (char *)got.data(),
+                       span_Byte, identity, 2.5f);
+      isPassed = isPassed && want == got;
+    }
+    ref.elemwiseSpan(kind, FLOAT32_32ALN, (const char *)fa.data(),
+                     (const char *)fb.data(), (char *)fwant.data(), span_Byte,
+                     identity, 2.5f);
+    isa.elemwiseSpan(kind, FLOAT32_32ALN, (const char *)fa.data(),
+                     (const char *)fb.data(), (char *)fgot.data(), span_Byte,
+                     identity, 2.5f);
+    isPassed = isPassed && fwant == fgot;
+  }
+
+  const std::vector<ElemwiseStage> stages = {
+      {ElemwiseKind::AFFINE, 3, src2, identity},
+      {ElemwiseKind::PROD, 0, src2, identity}};
+  ref.elemwiseFusedSpan(src1, (char *)want.data(), span_Byte, stages);
+  isa.elemwiseFusedSpan(src1, (char *)got.data(), span_Byte, stages);
+  isPassed = isPassed && want == got;
+
+  const int chunkItemNum = DPU_DMA_BFFR_BYTE / sizeof(int);
+  const int taps[8] = {1, -2, 3, -4, 5, -6, 7, -8};
+  for (const int kernelSize : {3, 5, 7, 8}) {
+    ref.selectConv1DChunk(kernelSize)(a.data() + 1, want.data(), taps,
+                                      chunkItemNum);
+    isa.selectConv1DChunk(kernelSize)(a.data() + 1, got.data(), taps,
+                                      chunkItemNum);
+    isPassed = isPassed && want == got;
+  }
+  // Sizes without a specialisation run the generic kernel in every variant.
+  isPassed = isPassed && ref.selectConv1DChunk(6) == nullptr &&
+             isa.selectConv1DChunk(6) == nullptr;
+  ref.filterChunk(a.data() + 1, want.data(), chunkItemNum);
+  isa.filterChunk(a.data() + 1, got.data(), chunkItemNum);
+  isPassed = isPassed && want == got;
+
+  for (const uint32_t n : {(uint32_t)chunkItemNum, 83u, 3u}) {
+    isPassed = isPassed &&
+               ref.macChunk(a.data() + 1, b.data() + 1, n) ==
+                   isa.macChunk(a.data() + 1, b.data() + 1, n) &&
+               ref.eudistChunk(a.data() + 1, b.data() + 1, n) ==
+                   isa.eudistChunk(a.data() + 1, b.data() + 1, n) &&
+               ref.countChunk(a.data() + 1, 2, n) ==
+                   isa.countChunk(a.data() + 1, 2, n);
+  }
+  std::vector<int64_t> partials(a.begin(), a.end());
+  isPassed = isPassed && ref.combinePartials(partials.data() + 1, 83) ==
+                             isa.combinePartials(partials.data() + 1, 83);
+  return isPassed;
+}
+
+int main() {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(-100, 100);
+  std::vector<int> a(16 * DPU_DMA_BFFR_BYTE / sizeof(int) + 1), b(a.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = dist(rng);
+    b[i] = dist(rng);
+  }
+
+  const CPUKernelTable &ref = scalar::getCPUKernelTable();
+  getCPUKernels(); // resolves and reports the variant in use
+  bool isPassed = true;
+  if (__builtin_cpu_supports("avx2"))
+    isPassed = isPassed && checkTable(ref, avx2::getCPUKernelTable(), a, b);
+  if (__builtin_cpu_supports("avx512f"))
+    isPassed = isPassed && checkTable(ref, avx512::getCPUKernelTable(), a, b);
+  std::cout << "CPU kernel variants: " << (isPassed ? "PASSED" : "FAILED")
+            << std::endl;
+  return isPassed ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#include "Operator/ElemwiseKernel.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace MetaPB::Operator;
+
+// Vector path against the scalar reference, cached and streamed stores,
+// with unaligned inputs and a remapped src2.
+template <ElemwiseKind kind>
+bool checkKind(const std::vector<int> &a, const std::vector<int> &b,
+               const size_t span_Byte) {
+  const int weight = 3;
+  const size_t itemNum = span_Byte / sizeof(int);
+  const size_t src2Wrap_Byte = 4 * DPU_DMA_BFFR_BYTE;
+  auto src2Offset = [&](size_t offset) { return offset % src2Wrap_Byte; };
+
+  std::vector<int> ref(itemNum);
+  for (size_t i = 0; i < itemNum; i++) {
+    ref[i] = elemwiseItem<kind>(
+        a[i + 1], b[1 + (i * sizeof(int)) % src2Wrap_Byte / sizeof(int)],
+        weight);
+  }
+
+  int *dst = (int *)std::aligned_alloc(64, span_Byte);
+  bool isPassed = true;
+  for (const size_t streamThreshold_Byte : {span_Byte, (size_t)0}) {
+    elemwiseSpan<kind>((const char *)(a.data() + 1),
+                       (const char *)(b.data() + 1), (char *)dst, span_Byte,
+                       src2Offset, weight, streamThreshold_Byte);
+    for (size_t i = 0; i < itemNum; i++) {
+      isPassed = isPassed && dst[i] == ref[i];
+    }
+  }
+  std::free(dst);
+  return isPassed;
+}
+
+// A fused chain matches its operators applied one after another.
+bool checkFused(const std::vector<int> &a, const std::vector<int> &b,
+                const size_t span_Byte) {
+  const int weight = 3;
+  const size_t itemNum = span_Byte / sizeof(int);
+  const size_t src2Wrap_Byte = 4 * DPU_DMA_BFFR_BYTE;
+  auto wrapped = [&](size_t offset) { return offset % src2Wrap_Byte; };
+  auto identity = [](size_t offset) { return offset; };
+  const char *src2 = (const char *)(b.data() + 1);
+  const std::vector<ElemwiseStage> stages = {
+      {ElemwiseKind::AFFINE, weight, src2, identity},
+      {ElemwiseKind::ADD, 0, src2, wrapped},
+      {ElemwiseKind::PROD, 0, src2, identity}};
+
+  std::vector<int> ref(itemNum);
+  for (size_t i = 0; i < itemNum; i++) {
+    int v = elemwiseItem<ElemwiseKind::AFFINE>(a[i + 1], b[i + 1], weight);
+    v = elemwiseItem<ElemwiseKind::ADD>(
+        v, b[1 + (i * sizeof(int)) % src2Wrap_Byte / sizeof(int)], 0);
+    ref[i] = elemwiseItem<ElemwiseKind::PROD>(v, b[i + 1], 0);
+  }
+
+  int *dst = (int *)std::aligned_alloc(64, span_Byte);
+  bool isPassed = true;
+  for (const size_t streamThreshold_Byte : {span_Byte, (size_t)0}) {
+    elemwiseFusedSpan((const char *)(a.data() + 1), (char *)dst, span_Byte,
+                      stages, streamThreshold_Byte);
+    for (size_t i = 0; i < itemNum; i++) {
+      isPassed = isPassed && dst[i] == ref[i];
+    }
+  }
+  std::free(dst);
+  return isPassed;
+}
+
+// A non-integer weight runs as the int the standalone AFFINE applies, fused
+// or not.
+bool checkFusedWeight(const std::vector<int> &a, const std::vector<int> &b,
+                      const size_t span_Byte) {
+  const float weight = 2.5f;
+  const size_t itemNum = span_Byte / sizeof(int);
+  auto identity = [](size_t offset) { return offset; };
+  const char *src1 = (const char *)(a.data() + 1);
+  const char *src2 = (const char *)(b.data() + 1);
+  // Stages as OperatorAFFINE and OperatorELEW_ADD hand them to the chain.
+  const std::vector<ElemwiseStage> stages = {
+      {ElemwiseKind::AFFINE, (int)weight, src2, identity},
+      {ElemwiseKind::ADD, 0, src2, identity}};
+
+  std::vector<int> unfused(itemNum), fused(itemNum);
+  elemwiseSpanOf<ElemwiseKind::AFFINE>(INT32_32ALN, src1, src2,
+                                       (char *)unfused.data(), span_Byte,
+                                       identity, weight);
+  elemwiseSpanOf<ElemwiseKind::ADD>(INT32_32ALN, (const char *)unfused.data(),
+                                    src2, (char *)unfused.data(), span_Byte,
+                                    identity);
+  elemwiseFusedSpan(src1, (char *)fused.data(), span_Byte, stages);
+  return fused == unfused && unfused[0] == 2 * a[1] + b[1] + b[1];
+}
+
+// Narrow and float elements through the Consensus type dispatch.
+template <typename T>
+bool checkElemType(const std::vector<int> &a, const std::vector<int> &b,
+                   const size_t span_Byte) {
+  const float weight = 2.5f;
+  const size_t itemNum = span_Byte / sizeof(T);
+  std::vector<T> ta(itemNum), tb(itemNum), ref(itemNum), dst(itemNum);
+  for (size_t i = 0; i < itemNum; i++) {
+    ta[i] = (T)a[i % a.size()];
+    tb[i] = (T)b[i % b.size()];
+    ref[i] = elemwiseItem<ElemwiseKind::AFFINE, T>(ta[i], tb[i], (T)weight);
+  }
+  elemwiseSpanOf<ElemwiseKind::AFFINE>(
+      MetaPB::Consensus::TypeVal<T>::value, (const char *)ta.data(),
+      (const char *)tb.data(), (char *)dst.data(), span_Byte,
+      [](size_t offset) { return offset; }, weight);
+  return dst == ref;
+}
+
+int main() {
+  const size_t span_Byte = 64 * DPU_DMA_BFFR_BYTE;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  std::vector<int> a(span_Byte / sizeof(int) + 1), b(a.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = dist(rng);
+    b[i] = dist(rng);
+  }
+
+  const bool isPassed = checkKind<ElemwiseKind::ADD>(a, b, span_Byte) &&
+                        checkKind<ElemwiseKind::PROD>(a, b, span_Byte) &&
+                        checkKind<ElemwiseKind::AFFINE>(a, b, span_Byte) &&
+                        checkFused(a, b, span_Byte) &&
+                        checkFusedWeight(a, b, span_Byte) &&
+                        checkElemType<int8_t>(a, b, span_Byte) &&
+                        checkElemType<int16_t>(a, b, span_Byte) &&
+                        checkElemType<float>(a, b, span_Byte);
+  std::cout << "Element-wise kernels: " << (isPassed ? "PASSED" : "FAILED")
+            << std::endl;
+  return isPassed ? 0 : 1;
+}
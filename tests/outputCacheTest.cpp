@@ -0,0 +1,50 @@
+#include "utils/OutputCache.hpp"
+#include <iostream>
+#include <vector>
+
+using MetaPB::utils::OutputCache;
+
+// Entries only turn visible once every piece landed, pinned entries survive
+// the budget, unpinned ones leave least recently used first.
+int main() {
+  OutputCache oc(3 << 10);
+  std::vector<char> a(1 << 10, 'a'), b(1 << 10, 'b'), c(2 << 10, 'c');
+
+  oc.fill(1, a.size(), 0, a.data(), 512);
+  bool isPassed = !oc.pin(1);
+  oc.fill(1, a.size(), 512, a.data() + 512, a.size() - 512);
+  isPassed = isPassed && oc.pin(1);
+  oc.unpinAll();
+
+  oc.fill(2, b.size(), 0, b.data(), b.size());
+  oc.fill(3, c.size(), 0, c.data(), c.size()); // evicts 1
+  isPassed = isPassed && !oc.pin(1) && oc.pin(2) && oc.pin(3);
+
+  std::vector<char> out(b.size());
+  isPassed = isPassed && oc.restore(2, out.data(), out.size()) && out == b;
+
+  oc.fill(4, c.size(), 0, c.data(), c.size()); // everything pinned
+  isPassed = isPassed && !oc.pin(4);
+  oc.unpinAll();
+  oc.fill(4, c.size(), 0, c.data(), c.size());
+  isPassed = isPassed && oc.pin(4);
+
+  // An entry whose last piece never landed is dropped at the end of the run
+  // instead of holding its bytes forever.
+  OutputCache partial(2 << 10);
+  partial.fill(5, c.size(), 0, c.data(), 512);
+  partial.unpinAll();
+  partial.fill(6, c.size(), 0, c.data(), c.size());
+  isPassed = isPassed && partial.pin(6) &&
+             partial.getCachedSize_Byte() == c.size();
+
+  std::vector<char> page(4099, 7);
+  const uint64_t hash = OutputCache::hashBytes(page.data(), page.size());
+  page.back() = 8;
+  isPassed =
+      isPassed && hash != OutputCache::hashBytes(page.data(), page.size());
+
+  std::cout << "OutputCache: " << (isPassed ? "PASSED" : "FAILED")
+            << std::endl;
+  return isPassed ? 0 : 1;
+}